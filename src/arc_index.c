@@ -0,0 +1,278 @@
+/**
+ * ARC index module
+ * Frames and ghost slots share one set of link arrays, ghost slot g being node capacity + g.
+ */
+
+#include "arc_index.h"
+
+static long long int max_of(long long int a, long long int b) {
+    return a > b ? a : b;
+}
+
+static long long int min_of(long long int a, long long int b) {
+    return a < b ? a : b;
+}
+
+/**
+ * Append a node at the most recently used end of a list
+ * @param index
+ * @param list
+ * @param node
+ */
+static void push_node(arc_index_t* index, char list, long long int node) {
+    arc_list_t* l = &index->lists[(int)list];
+    index->list[node] = list;
+    index->prev[node] = l->tail;
+    index->next[node] = -1;
+    if (l->tail >= 0) {
+        index->next[l->tail] = node;
+    } else {
+        l->head = node;
+    }
+    l->tail = node;
+    l->size++;
+}
+
+/**
+ * Unlink a node from the list it is in
+ * @param index
+ * @param node
+ */
+static void unlink_node(arc_index_t* index, long long int node) {
+    arc_list_t* l = &index->lists[(int)index->list[node]];
+    assert(index->list[node] != ARC_NONE);
+    if (index->prev[node] >= 0) {
+        index->next[index->prev[node]] = index->next[node];
+    } else {
+        l->head = index->next[node];
+    }
+    if (index->next[node] >= 0) {
+        index->prev[index->next[node]] = index->prev[node];
+    } else {
+        l->tail = index->prev[node];
+    }
+    index->list[node] = ARC_NONE;
+    l->size--;
+}
+
+/**
+ * Drop a ghost, clearing the page table entry that refers to it
+ * @param index
+ * @param node
+ */
+static void drop_ghost(arc_index_t* index, long long int node) {
+    unlink_node(index, node);
+    *index->ghost_owner[node - index->capacity] = -1;
+    index->ghost_owner[node - index->capacity] = NULL;
+    index->next[node] = index->free_ghost;
+    index->free_ghost = node;
+}
+
+/**
+ * Returns an unused ghost slot, dropping the oldest ghost if every slot is in use
+ * @param index
+ * @return
+ */
+static long long int take_ghost(arc_index_t* index) {
+    if (index->free_ghost < 0) {
+        arc_list_t* oldest = index->lists[ARC_B1].size > 0 ? &index->lists[ARC_B1] : &index->lists[ARC_B2];
+        drop_ghost(index, oldest->head);
+    }
+    long long int node = index->free_ghost;
+    index->free_ghost = index->next[node];
+    return node;
+}
+
+/**
+ * Move the target size of T1, keeping it within [0, capacity]
+ * @param index
+ * @param delta
+ */
+static void adapt(arc_index_t* index, long long int delta) {
+    long long int target = min_of(max_of(index->target + delta, 0), index->capacity);
+    index->target_moved += target > index->target ? target - index->target : index->target - target;
+    index->target = target;
+    index->target_min = min_of(index->target_min, target);
+    index->target_max = max_of(index->target_max, target);
+}
+
+/**
+ * Create an ARC index with no frames in it
+ * @param frame_count
+ * @return
+ */
+arc_index_t* create_arc_index(long long int frame_count) {
+    arc_index_t* index = malloc(sizeof(*index));
+    assert(index);
+    index->capacity = frame_count;
+    /* A ghost is only made when a frame is evicted, and ARC keeps at most twice the frames in its lists */
+    index->node_count = frame_count + 2 * frame_count;
+    index->target = 0;
+    index->target_min = 0;
+    index->target_max = 0;
+    index->target_moved = 0;
+    for (int i=0; i<ARC_LIST_COUNT; i++) {
+        index->lists[i].head = -1;
+        index->lists[i].tail = -1;
+        index->lists[i].size = 0;
+    }
+    index->prev = malloc(sizeof(*index->prev) * (index->node_count + 1));
+    index->next = malloc(sizeof(*index->next) * (index->node_count + 1));
+    index->list = calloc(index->node_count + 1, sizeof(*index->list));
+    index->ghost_owner = calloc(2 * frame_count + 1, sizeof(*index->ghost_owner));
+    assert(index->prev && index->next && index->list && index->ghost_owner);
+    index->free_ghost = -1;
+    for (long long int i=index->node_count-1; i>=frame_count; i--) {
+        index->next[i] = index->free_ghost;
+        index->free_ghost = i;
+    }
+    return index;
+}
+
+/**
+ * Free an ARC index
+ * @param index
+ */
+void free_arc_index(arc_index_t* index) {
+    assert(index);
+    free(index->prev);
+    free(index->next);
+    free(index->list);
+    free(index->ghost_owner);
+    free(index);
+}
+
+/**
+ * Add a frame that a page has just been loaded into.
+ * A page remembered by a ghost goes to T2 and adapts the target, any other page goes to T1.
+ * @param index
+ * @param frame_number
+ * @param ghost ghost slot of the page, set to -1 as the page is no longer a ghost
+ */
+void arc_index_insert(arc_index_t* index, long long int frame_number, long long int* ghost) {
+    assert(index->list[frame_number] == ARC_NONE);
+    if (*ghost >= 0) {
+        long long int node = index->capacity + *ghost;
+        long long int b1 = index->lists[ARC_B1].size;
+        long long int b2 = index->lists[ARC_B2].size;
+        /* A miss in B1 means T1 was too small, a miss in B2 means T2 was */
+        if (index->list[node] == ARC_B1) {
+            adapt(index, max_of(b2 / b1, 1));
+        } else {
+            adapt(index, -max_of(b1 / b2, 1));
+        }
+        drop_ghost(index, node);
+        push_node(index, ARC_T2, frame_number);
+    } else {
+        push_node(index, ARC_T1, frame_number);
+    }
+
+    /* Keep |T1| + |B1| <= c and |T1| + |T2| + |B1| + |B2| <= 2c */
+    arc_list_t* lists = index->lists;
+    while (lists[ARC_T1].size + lists[ARC_B1].size > index->capacity && lists[ARC_B1].size > 0) {
+        drop_ghost(index, lists[ARC_B1].head);
+    }
+    while (lists[ARC_T1].size + lists[ARC_T2].size + lists[ARC_B1].size + lists[ARC_B2].size > 2 * index->capacity
+           && lists[ARC_B2].size > 0) {
+        drop_ghost(index, lists[ARC_B2].head);
+    }
+}
+
+/**
+ * Record a reference to a frame, which makes it the most recently used frame of its list.
+ * A frame referenced again moves from T1 to T2.
+ * @param index
+ * @param frame_number
+ * @param again whether the page has been referenced before since it was loaded
+ */
+void arc_index_reference(arc_index_t* index, long long int frame_number, bool again) {
+    char list = index->list[frame_number];
+    if (list == ARC_NONE) {
+        return;
+    }
+    unlink_node(index, frame_number);
+    push_node(index, list == ARC_T1 && !again ? ARC_T1 : ARC_T2, frame_number);
+}
+
+/**
+ * Returns the least recently used frame of a list that is not owned by the given pid
+ * @param index
+ * @param list
+ * @param owners
+ * @param ignore
+ * @return -1 if there is no such frame
+ */
+static long long int least_recent(arc_index_t* index, char list, long long int* owners, long long int ignore) {
+    /* The skipped frames belong to the process being allocated, which holds only a few frames */
+    for (long long int node=index->lists[(int)list].head; node >= 0; node=index->next[node]) {
+        if (owners[node] != ignore) {
+            return node;
+        }
+    }
+    return -1;
+}
+
+/**
+ * Returns a frame to evict: from T1 if it is larger than its target, otherwise from T2
+ * @param index
+ * @param owners the pid owning each frame
+ * @param ignore pid whose frames must not be chosen
+ * @return
+ */
+long long int arc_index_replace(arc_index_t* index, long long int* owners, long long int ignore) {
+    char first = index->lists[ARC_T1].size > 0 && index->lists[ARC_T1].size > index->target ? ARC_T1 : ARC_T2;
+    long long int frame_number = least_recent(index, first, owners, ignore);
+    if (frame_number < 0) {
+        frame_number = least_recent(index, first == ARC_T1 ? ARC_T2 : ARC_T1, owners, ignore);
+    }
+    assert(frame_number >= 0);
+    return frame_number;
+}
+
+/**
+ * Remove an evicted frame, remembering its page with a ghost in B1 or B2
+ * @param index
+ * @param frame_number
+ * @param ghost set to the ghost slot of the page
+ */
+void arc_index_evict(arc_index_t* index, long long int frame_number, long long int* ghost) {
+    char list = index->list[frame_number];
+    assert(list == ARC_T1 || list == ARC_T2);
+    unlink_node(index, frame_number);
+    long long int node = take_ghost(index);
+    push_node(index, list == ARC_T1 ? ARC_B1 : ARC_B2, node);
+    index->ghost_owner[node - index->capacity] = ghost;
+    *ghost = node - index->capacity;
+}
+
+/**
+ * Remove a frame freed by its process, without remembering its page
+ * @param index
+ * @param frame_number
+ */
+void arc_index_remove(arc_index_t* index, long long int frame_number) {
+    if (index->list[frame_number] != ARC_NONE) {
+        unlink_node(index, frame_number);
+    }
+}
+
+/**
+ * Drop the ghost of a page that will not be loaded again
+ * @param index
+ * @param ghost ghost slot of the page, set to -1
+ */
+void arc_index_forget(arc_index_t* index, long long int* ghost) {
+    if (*ghost >= 0) {
+        drop_ghost(index, index->capacity + *ghost);
+    }
+}
+
+/**
+ * Print how the target size of T1 has adapted, after the other statistics:
+ * the final target with its minimum and maximum, then the total distance it moved
+ * @param index
+ */
+void print_arc_index(arc_index_t* index) {
+    printf("ARC target %lld, %lld, %lld\n", index->target, index->target_min, index->target_max);
+    printf("ARC target moved %lld\n", index->target_moved);
+}
@@ -0,0 +1,64 @@
+/**
+ * ARC index module.
+ * Keeps the lists of the adaptive replacement cache: T1 holds frames referenced once since they were loaded,
+ * T2 frames referenced again, and the ghost lists B1 and B2 remember pages recently evicted from T1 and T2.
+ * A page loaded while it has a ghost moves the target size of T1 towards the list that ghost came from.
+ * Lists are linked through arrays indexed by frame and ghost slot, so every operation is O(1),
+ * and there are at most twice as many ghosts as frames.
+ */
+
+#ifndef SCHEDULER_ARC_INDEX_H
+#define SCHEDULER_ARC_INDEX_H
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <assert.h>
+#include <stdbool.h>
+
+#define ARC_NONE 0
+#define ARC_T1 1
+#define ARC_T2 2
+#define ARC_B1 3
+#define ARC_B2 4
+#define ARC_LIST_COUNT 5
+
+typedef struct arc_list {
+    /* Least recently used end */
+    long long int head;
+    /* Most recently used end */
+    long long int tail;
+    long long int size;
+} arc_list_t;
+
+typedef struct arc_index {
+    /* Number of frames. Nodes below it are frames, the rest are ghost slots */
+    long long int capacity;
+    long long int node_count;
+    /* Target size of T1 */
+    long long int target;
+    /* Range and total distance the target has moved through */
+    long long int target_min;
+    long long int target_max;
+    long long int target_moved;
+    arc_list_t lists[ARC_LIST_COUNT];
+    long long int* prev;
+    long long int* next;
+    /* The list each node is in */
+    char* list;
+    /* The ghost slot field of the page table entry each ghost remembers */
+    long long int** ghost_owner;
+    /* Unused ghost slots, linked through next */
+    long long int free_ghost;
+} arc_index_t;
+
+arc_index_t* create_arc_index(long long int frame_count);
+void free_arc_index(arc_index_t* index);
+void arc_index_insert(arc_index_t* index, long long int frame_number, long long int* ghost);
+void arc_index_reference(arc_index_t* index, long long int frame_number, bool again);
+long long int arc_index_replace(arc_index_t* index, long long int* owners, long long int ignore);
+void arc_index_evict(arc_index_t* index, long long int frame_number, long long int* ghost);
+void arc_index_remove(arc_index_t* index, long long int frame_number);
+void arc_index_forget(arc_index_t* index, long long int* ghost);
+void print_arc_index(arc_index_t* index);
+
+#endif //SCHEDULER_ARC_INDEX_H
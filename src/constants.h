@@ -18,6 +18,28 @@
 #define SWAPPING -2
 #define VIRTUAL_MEMORY -3
 #define CUSTOMISED_MEMORY -4
+#define CLOCK_MEMORY -5
+#define WSCLOCK_MEMORY -6
+#define ARC_MEMORY -7
+#define OPTIMAL_MEMORY -8
+#define MGLRU_MEMORY -9
+#define PAGE_LRU_MEMORY -10
+/**
+ * Working set window of WSClock in ticks.
+ * Unreferenced pages used longer ago than this are outside the working set of their process.
+ */
+#define WSCLOCK_WINDOW 10
+/**
+ * Number of generations of the multi-generational LRU, and ticks between two agings
+ */
+#define MGLRU_GENERATIONS 4
+#define MGLRU_AGING_INTERVAL 10
+/**
+ * Counters age lazily: each frame records the aging tick its counter was last brought up to date,
+ * and the shifts it is owed are applied when the counter is read.
+ * Counters only use their lowest 8 bits, so no more than 8 shifts are ever owed.
+ */
+#define MAX_AGING_SHIFT 8
 /**
  * Page Size in Bytes
  */
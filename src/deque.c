@@ -24,14 +24,42 @@
 #include <assert.h>
 #include "deque.h"
 
+#define DEQUE_INITIAL_CAPACITY 16
+
+// slot of the element i places above the bottom
+static int slot(Deque *deque, int i) {
+    return (deque->first + i) & (deque->capacity - 1);
+}
+
+// double the capacity when full, unwrapping the elements to start at slot 0
+static void grow_if_full(Deque *deque) {
+    if (deque->size < deque->capacity) {
+        return;
+    }
+    tNode **items = malloc(sizeof(*items) * deque->capacity * 2);
+    assert(items);
+    for (int i = 0; i < deque->size; i++) {
+        items[i] = deque->items[slot(deque, i)];
+    }
+    free(deque->items);
+    deque->items = items;
+    deque->capacity *= 2;
+    deque->first = 0;
+}
+
 // Create a new empty Deque and return a pointer to it
 //
 // DO NOT CHANGE THIS FUNCTION SIGNATURE
 Deque *new_deque(void (*print)(void *)) {
     Deque *newdq = (Deque*)malloc(sizeof(Deque));
-    /* We don't want the linked list to free data it contains in this case,
-     * so a empty cleaner is provided */
-    newdq->list = new_dlist(empty_cleaner, print);
+    assert(newdq);
+    /* The deque only holds pointers, the processes are not owned by it */
+    newdq->capacity = DEQUE_INITIAL_CAPACITY;
+    newdq->items = malloc(sizeof(*newdq->items) * newdq->capacity);
+    assert(newdq->items);
+    newdq->first = 0;
+    newdq->size = 0;
+    newdq->print = print;
     return newdq;
 }
 
@@ -39,8 +67,7 @@ Deque *new_deque(void (*print)(void *)) {
 //
 // DO NOT CHANGE THIS FUNCTION SIGNATURE
 void free_deque(Deque *deque) {
-    // call free_dlist to free each node in the dlist
-    free_dlist(deque->list);
+    free(deque->items);
     // free the structure itself
     free(deque);
 }
@@ -52,7 +79,9 @@ void free_deque(Deque *deque) {
 //
 // DO NOT CHANGE THIS FUNCTION SIGNATURE
 void deque_push(Deque *deque, tNode* data) {
-    dlist_add_end(deque->list, data);
+    grow_if_full(deque);
+    deque->items[slot(deque, deque->size)] = data;
+    deque->size++;
 }
 
 // Add a Point to the bottom of a Deque
@@ -62,8 +91,10 @@ void deque_push(Deque *deque, tNode* data) {
 //
 // DO NOT CHANGE THIS FUNCTION SIGNATURE
 void deque_insert(Deque *deque, tNode* data) {
-    // TODO: Implement deque_insert()
-    dlist_add_start(deque->list, data);
+    grow_if_full(deque);
+    deque->first = slot(deque, -1);
+    deque->items[deque->first] = data;
+    deque->size++;
 }
 
 // Remove and return the top Point from a Deque
@@ -73,24 +104,28 @@ void deque_insert(Deque *deque, tNode* data) {
 //
 // DO NOT CHANGE THIS FUNCTION SIGNATURE
 tNode* deque_pop(Deque *deque) {
-    // TODO: Implement deque_pop()
-    return dlist_remove_end(deque->list);
+    assert(deque->size > 0);
+    deque->size--;
+    return deque->items[slot(deque, deque->size)];
 }
 
+// print from the bottom to the top
 void print_deque(Deque *deque){
-    print_dlist(deque->list);
+    for (int i = 0; i < deque->size; i++) {
+        deque->print(deque->items[slot(deque, i)]);
+    }
 }
 
 tNode* last_to_pop(Deque *deque) {
-    if (deque->list->head) {
-        return deque->list->head->data;
+    if (deque->size > 0) {
+        return deque->items[deque->first];
     }
     return NULL;
 }
 
 tNode* next_to_pop(Deque *deque) {
-    if (deque->list->tail) {
-        return deque->list->tail->data;
+    if (deque->size > 0) {
+        return deque->items[slot(deque, deque->size - 1)];
     }
     return NULL;
 }
@@ -102,8 +137,11 @@ tNode* next_to_pop(Deque *deque) {
 //
 // DO NOT CHANGE THIS FUNCTION SIGNATURE
 tNode* deque_remove(Deque *deque) {
-    // TODO: Implement deque_remove()
-    return dlist_remove_start(deque->list);
+    assert(deque->size > 0);
+    tNode *data = deque->items[deque->first];
+    deque->first = slot(deque, 1);
+    deque->size--;
+    return data;
 }
 
 // Return the number of Points in a Deque
@@ -113,5 +151,5 @@ tNode* deque_remove(Deque *deque) {
 //
 // DO NOT CHANGE THIS FUNCTION SIGNATURE
 int deque_size(Deque *deque) {
-    return dlist_size(deque->list);
+    return deque->size;
 }
\ No newline at end of file
@@ -15,14 +15,19 @@
 #ifndef DEQUE_H
 #define DEQUE_H
 
-#include "dlist.h"
 #include "process.h"
 // You may change the definition of Deque but DO NOT change the name
 typedef struct deque Deque;
 typedef process_t tNode;
 
+// A growable ring buffer, the bottom at items[first] and the top size - 1 slots after it
 struct deque {
-    Dlist *list;
+    tNode **items;
+    // always a power of two
+    int capacity;
+    int first;
+    int size;
+    void (*print)(void *);
 };
 
 // Create a new empty Deque and return a pointer to it
@@ -38,7 +43,7 @@ void free_deque(Deque *deque);
 // Add a Point to the top of a Deque
 //
 // TODO: Fill in the runtime of this function
-// Runtime: O(n)
+// Runtime: O(1) amortised
 //
 // DO NOT CHANGE THIS FUNCTION SIGNATURE
 void deque_push(Deque *deque, tNode* data);
@@ -46,7 +51,7 @@ void deque_push(Deque *deque, tNode* data);
 // Add a Point to the bottom of a Deque
 //
 // TODO: Fill in the runtime of this function
-// Runtime: O(1)
+// Runtime: O(1) amortised
 //
 // DO NOT CHANGE THIS FUNCTION SIGNATURE
 void deque_insert(Deque *deque, tNode* data);
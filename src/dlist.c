@@ -22,9 +22,26 @@ Dlist* new_dlist(void (*clean)(void *), void (*print)(void *)){
     new->tail = NULL;
     new->size = 0;
     new->clean = clean;
+    new->intrusive = false;
     return new;
 }
 
+// create a dlist whose nodes are embedded in the data they link
+Dlist* new_intrusive_dlist(void (*clean)(void *), void (*print)(void *)) {
+    Dlist *new = new_dlist(clean, print);
+    new->intrusive = true;
+    return new;
+}
+
+// clean the data of a node unlinked from the list, freeing the node unless it is part of the data
+static void release_node(Dlist *ddl, Node *node) {
+    if (ddl->intrusive) {
+        ddl->clean(node->data);
+    } else {
+        free_node(node, ddl->clean);
+    }
+}
+
 void print_dlist(Dlist* list) {
     Node *curr = list->head;
     // free list node by node
@@ -43,7 +60,7 @@ void free_dlist(Dlist *ddl) {
     while (curr) {
         // record next node
         next = curr->next;
-        free_node(curr, ddl->clean);
+        release_node(ddl, curr);
         curr = next;
     }
     // free the dlist itself
@@ -76,16 +93,20 @@ void free_dlist(Dlist *ddl) {
 // helper function to clear memory of a node
 void free_node(Node *node, void (*clean)(void *)) {
     clean(node->data);
-    free(node);
+    pool_free(node, sizeof(*node));
 }
 
 // add an element to the front of a list
 // This operation is O(1)
 Node* dlist_add_start(Dlist *ddl, Data data){
-    assert(ddl != NULL);
+    assert(ddl != NULL && !ddl->intrusive);
+    return dlist_link_start(ddl, new_node(), data);
+}
 
-    // create a new node
-    Node *new = new_node();
+// link a node owned by the caller to the front of a list
+// This operation is O(1)
+Node* dlist_link_start(Dlist *ddl, Node* new, Data data) {
+    assert(ddl != NULL);
     new->data = data;
     new->next = ddl->head; // next will be the old first node (may be null)
     new->prev = NULL; // head has no prev node
@@ -111,10 +132,15 @@ Node* dlist_add_start(Dlist *ddl, Data data){
 // add an element to the back of a list
 // This operation is O(1)
 Node* dlist_add_end(Dlist *ddl, Data data) {
-    assert(ddl != NULL);
-
+    assert(ddl != NULL && !ddl->intrusive);
     // we'll need a new list node to store this data
-    Node *new = new_node();
+    return dlist_link_end(ddl, new_node(), data);
+}
+
+// link a node owned by the caller to the back of a list
+// This operation is O(1)
+Node* dlist_link_end(Dlist *ddl, Node* new, Data data) {
+    assert(ddl != NULL);
     new->data = data;
     new->next = NULL; // as the last node, there's no next node
     new->prev = ddl->tail; // its prev was the old tail
@@ -138,8 +164,9 @@ Node* dlist_add_end(Dlist *ddl, Data data) {
 // remove and return the first element from a doubly linked list
 // this operation is O(1)
 // error if the list is empty (so first ensure list_size() > 0)
+// not for intrusive lists, whose data is cleaned with the node, use dlist_remove
 Data dlist_remove_start(Dlist *ddl) {
-    assert(ddl != NULL);
+    assert(ddl != NULL && !ddl->intrusive);
     assert(ddl->size > 0);
 
     // we'll need to save the data to return it
@@ -163,46 +190,46 @@ Data dlist_remove_start(Dlist *ddl) {
     ddl->size--;
 
     // free node
-    free_node(curr, ddl->clean);
+    release_node(ddl, curr);
 
     // return data retrieved
     return data;
 }
 
-// Malloc a new node, return its address
+// Allocate a new node from the pool, return its address
 Node *new_node() {
-    Node *node = malloc(sizeof *node);
+    Node *node = pool_alloc(sizeof *node);
     assert(node);
     return node;
 }
 
 
+// insert an element right after the given node of the list
+// This operation is O(1)
 Node* dlist_insert_after(Dlist *ddl, Node* after, Data newData) {
+    assert(ddl != NULL && !ddl->intrusive);
+    return dlist_link_after(ddl, after, new_node(), newData);
+}
+
+// link a node owned by the caller right after the given node of the list
+// This operation is O(1)
+Node* dlist_link_after(Dlist *ddl, Node* after, Node* new, Data newData) {
     assert(ddl != NULL);
     assert(ddl->size > 0);
-    Node* current = ddl->head;
-    while (current) {
-        if (current == after) {
-            Node* new = (Node*)malloc(sizeof(*new));
-            new->data = newData;
-            new->prev = current;
-            new->next = current->next;
-            if (current->next) {
-                current->next->prev = new;
-            }
-            current->next = new;
-            if (new->prev == NULL) {
-                ddl->head = new;
-            }
-            else if (new->next == NULL) {
-                ddl->tail = new;
-            }
-            ddl->size++;
-            return new;
-        }
-        current = current -> next;
+    assert(after != NULL);
+
+    new->data = newData;
+    new->prev = after;
+    new->next = after->next;
+    if (after->next) {
+        after->next->prev = new;
+    } else {
+        // inserted after the last node
+        ddl->tail = new;
     }
-    return NULL;
+    after->next = new;
+    ddl->size++;
+    return new;
 }
 
 Node* dlist_remove(Dlist *ddl, Node* toRemove) {
@@ -219,16 +246,16 @@ Node* dlist_remove(Dlist *ddl, Node* toRemove) {
     } else {
         ddl->tail = toRemove->prev;
     }
-    free_node(toRemove, ddl->clean);
-
     ddl->size--;
+    release_node(ddl, toRemove);
     return NULL;
 }
 // Remove the last element in a doubly linked list.
 // This operation is (1)
 // Make sure list has at least 1 element.
+// Not for intrusive lists, whose data is cleaned with the node, use dlist_remove.
 Data dlist_remove_end(Dlist *ddl) {
-    assert(ddl != NULL);
+    assert(ddl != NULL && !ddl->intrusive);
     assert(ddl->size > 0);
 
     // we'll need to save the data to return it
@@ -250,7 +277,7 @@ Data dlist_remove_end(Dlist *ddl) {
     ddl->size--;
 
     // we're finished with the list node holding this data
-    free_node(curr, ddl->clean);
+    release_node(ddl, curr);
 
     // done!
     return data;
@@ -24,6 +24,8 @@ struct dlist {
     Node *head;
     Node *tail;
     int size;
+    // whether nodes are embedded in their data rather than allocated by the list
+    bool intrusive;
     void (*clean)(void *);
     void (*print)(void *);
 };
@@ -33,10 +35,15 @@ struct dlist {
 // helper function to create a new dlist and return its address
 Dlist* new_dlist(void (*clean)(void *), void (*print)(void *));
 
+// create a dlist whose nodes are fields of the data they link, so linking never allocates
+// and removing a node only cleans its data. Nodes are added with dlist_link_* and removed with
+// dlist_remove only, as the data returned by dlist_remove_start/end would already be cleaned
+Dlist* new_intrusive_dlist(void (*clean)(void *), void (*print)(void *));
+
 //free a dlist node by node
 void free_dlist(Dlist *ddl);
 
-// Malloc a new node, return its address
+// Allocate a new node from the pool, return its address
 Node *new_node();
 
 // helper function to clear memory of a node
@@ -69,6 +76,15 @@ Node* dlist_insert_after(Dlist *ddl, Node* after, Data newData);
 
 Node* dlist_remove(Dlist *ddl, Node* toRemove);
 
+// link a node owned by the caller, usually a field of data, to the front of a list
+Node* dlist_link_start(Dlist *ddl, Node* node, Data data);
+
+// link a node owned by the caller to the back of a list
+Node* dlist_link_end(Dlist *ddl, Node* node, Data data);
+
+// link a node owned by the caller right after the given node of the list
+Node* dlist_link_after(Dlist *ddl, Node* after, Node* node, Data data);
+
 int dlist_test();
 
 void empty_cleaner(void* data);
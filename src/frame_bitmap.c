@@ -0,0 +1,148 @@
+/**
+ * Frame bitmap module
+ * Used for free frames, which start all set, and for LFU's frames whose counter has aged to 0, which start empty.
+ */
+
+#include "frame_bitmap.h"
+
+#define BITS_PER_WORD 64
+
+static long long int word_count(long long int bits) {
+    return (bits + BITS_PER_WORD - 1) / BITS_PER_WORD;
+}
+
+/**
+ * Create a bitmap where every frame is either set or clear
+ * @param frame_count
+ * @param set
+ * @return
+ */
+frame_bitmap_t* create_frame_bitmap(long long int frame_count, bool set) {
+    frame_bitmap_t* bitmap = malloc(sizeof(*bitmap));
+    assert(bitmap);
+    bitmap->frame_count = frame_count;
+    bitmap->level_count = 0;
+    long long int bits = frame_count;
+    do {
+        assert(bitmap->level_count < FRAME_BITMAP_MAX_LEVEL);
+        long long int length = word_count(bits);
+        uint64_t* words = calloc(length > 0 ? length : 1, sizeof(*words));
+        assert(words);
+        /* Set the first 'bits' bits */
+        for (long long int i=0; set && i<bits; i++) {
+            words[i / BITS_PER_WORD] |= (uint64_t)1 << (i % BITS_PER_WORD);
+        }
+        bitmap->levels[bitmap->level_count] = words;
+        bitmap->level_length[bitmap->level_count] = length;
+        bitmap->level_count++;
+        bits = length;
+    } while (bits > 1);
+    return bitmap;
+}
+
+/**
+ * Free a frame bitmap
+ * @param bitmap
+ */
+void free_frame_bitmap(frame_bitmap_t* bitmap) {
+    assert(bitmap);
+    for (int level=0; level<bitmap->level_count; level++) {
+        free(bitmap->levels[level]);
+    }
+    free(bitmap);
+}
+
+/**
+ * Set the bit of a frame
+ * @param bitmap
+ * @param frame_number
+ */
+void frame_bitmap_set(frame_bitmap_t* bitmap, long long int frame_number) {
+    assert(frame_number >= 0 && frame_number < bitmap->frame_count);
+    long long int index = frame_number;
+    for (int level=0; level<bitmap->level_count; level++) {
+        uint64_t* word = &bitmap->levels[level][index / BITS_PER_WORD];
+        bool was_empty = *word == 0;
+        *word |= (uint64_t)1 << (index % BITS_PER_WORD);
+        if (!was_empty) {
+            break;
+        }
+        index /= BITS_PER_WORD;
+    }
+}
+
+/**
+ * Clear the bit of a frame
+ * @param bitmap
+ * @param frame_number
+ */
+void frame_bitmap_clear(frame_bitmap_t* bitmap, long long int frame_number) {
+    assert(frame_number >= 0 && frame_number < bitmap->frame_count);
+    long long int index = frame_number;
+    for (int level=0; level<bitmap->level_count; level++) {
+        uint64_t* word = &bitmap->levels[level][index / BITS_PER_WORD];
+        *word &= ~((uint64_t)1 << (index % BITS_PER_WORD));
+        if (*word != 0) {
+            break;
+        }
+        index /= BITS_PER_WORD;
+    }
+}
+
+/**
+ * Returns if the bit of a frame is set
+ * @param bitmap
+ * @param frame_number
+ * @return
+ */
+bool frame_bitmap_test(frame_bitmap_t* bitmap, long long int frame_number) {
+    assert(frame_number >= 0 && frame_number < bitmap->frame_count);
+    return (bitmap->levels[0][frame_number / BITS_PER_WORD] >> (frame_number % BITS_PER_WORD)) & 1;
+}
+
+/**
+ * Returns the set frame with the lowest frame number
+ * @param bitmap
+ * @return -1 if no frame is set
+ */
+long long int frame_bitmap_lowest(frame_bitmap_t* bitmap) {
+    return frame_bitmap_next(bitmap, 0);
+}
+
+/**
+ * Returns the lowest set frame with a frame number no less than from
+ * @param bitmap
+ * @param from
+ * @return -1 if there is no such frame
+ */
+long long int frame_bitmap_next(frame_bitmap_t* bitmap, long long int from) {
+    if (from >= bitmap->frame_count) {
+        return -1;
+    }
+    /* Climb until a word has a set bit at or after the position */
+    long long int index = from;
+    int level = 0;
+    while (true) {
+        if (level == bitmap->level_count) {
+            return -1;
+        }
+        long long int word_index = index / BITS_PER_WORD;
+        if (word_index >= bitmap->level_length[level]) {
+            return -1;
+        }
+        uint64_t word = bitmap->levels[level][word_index] & (~(uint64_t)0 << (index % BITS_PER_WORD));
+        if (word) {
+            index = word_index * BITS_PER_WORD + __builtin_ctzll(word);
+            break;
+        }
+        /* The next word of this level is the next bit of the level above */
+        index = word_index + 1;
+        level++;
+    }
+    /* Descend to the lowest set frame below it */
+    while (level > 0) {
+        level--;
+        index = index * BITS_PER_WORD + __builtin_ctzll(bitmap->levels[level][index]);
+    }
+    return index;
+}
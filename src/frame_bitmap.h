@@ -0,0 +1,33 @@
+/**
+ * Frame bitmap module.
+ * A hierarchical bitmap over page frames. Each level summarises which words of the level below
+ * have a bit set, so the lowest set frame is found with one find-first-set per level.
+ */
+
+#ifndef SCHEDULER_FRAME_BITMAP_H
+#define SCHEDULER_FRAME_BITMAP_H
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <assert.h>
+#include <stdbool.h>
+
+#define FRAME_BITMAP_MAX_LEVEL 8
+
+typedef struct frame_bitmap {
+    long long int frame_count;
+    int level_count;
+    /* levels[0] has a bit per frame, levels[k] has a bit per word of levels[k-1], set if anything below is set */
+    uint64_t* levels[FRAME_BITMAP_MAX_LEVEL];
+    long long int level_length[FRAME_BITMAP_MAX_LEVEL];
+} frame_bitmap_t;
+
+frame_bitmap_t* create_frame_bitmap(long long int frame_count, bool set);
+void free_frame_bitmap(frame_bitmap_t* bitmap);
+void frame_bitmap_set(frame_bitmap_t* bitmap, long long int frame_number);
+void frame_bitmap_clear(frame_bitmap_t* bitmap, long long int frame_number);
+bool frame_bitmap_test(frame_bitmap_t* bitmap, long long int frame_number);
+long long int frame_bitmap_lowest(frame_bitmap_t* bitmap);
+long long int frame_bitmap_next(frame_bitmap_t* bitmap, long long int from);
+
+#endif //SCHEDULER_FRAME_BITMAP_H
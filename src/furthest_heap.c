@@ -0,0 +1,91 @@
+/**
+ * Furthest heap module
+ * Ties on next use are broken as LRU breaks them, by last access and then by creation order,
+ * so OPT falls back to LRU among processes that are not used again.
+ */
+
+#include "furthest_heap.h"
+#include "virtual_memory.h"
+
+#define FURTHEST_HEAP_INITIAL_CAPACITY 16
+
+/**
+ * Orders page tables so the one to evict first is the smallest
+ * @param a
+ * @param b
+ * @return
+ */
+static int compare_furthest(void* a, void* b) {
+    page_table_node_t* page_table_a = a;
+    page_table_node_t* page_table_b = b;
+    if (page_table_a->next_use != page_table_b->next_use) {
+        return page_table_a->next_use > page_table_b->next_use ? -1 : 1;
+    }
+    if (page_table_a->last_access != page_table_b->last_access) {
+        return page_table_a->last_access < page_table_b->last_access ? -1 : 1;
+    }
+    if (page_table_a->created != page_table_b->created) {
+        return page_table_a->created < page_table_b->created ? -1 : 1;
+    }
+    return 0;
+}
+
+/**
+ * Create an empty furthest heap
+ * @return
+ */
+furthest_heap_t* create_furthest_heap() {
+    return create_d_ary_heap(FURTHEST_HEAP_INITIAL_CAPACITY, 2, compare_furthest, offsetof(page_table_node_t, furthest_index));
+}
+
+/**
+ * Free a furthest heap. The page tables are owned by the memory manager.
+ * @param heap
+ */
+void free_furthest_heap(furthest_heap_t* heap) {
+    assert(heap);
+    free_heap(heap);
+}
+
+/**
+ * Add a page table to the heap
+ * @param heap
+ * @param page_table
+ */
+void furthest_heap_insert(furthest_heap_t* heap, page_table_node_t* page_table) {
+    assert(page_table->furthest_index < 0);
+    heap_insert(heap, page_table);
+}
+
+/**
+ * Remove a page table from the heap
+ * @param heap
+ * @param page_table
+ */
+void furthest_heap_remove(furthest_heap_t* heap, page_table_node_t* page_table) {
+    heap_remove(heap, page_table);
+}
+
+/**
+ * Restore the heap order after the next use or last access of a page table has changed
+ * @param heap
+ * @param page_table
+ */
+void furthest_heap_update(furthest_heap_t* heap, page_table_node_t* page_table) {
+    heap_update_key(heap, page_table);
+}
+
+/**
+ * Returns the page table used furthest in the future, other than the one of the given pid
+ * @param heap
+ * @param ignore
+ * @return NULL if there is no such page table
+ */
+page_table_node_t* furthest_heap_max(furthest_heap_t* heap, long long int ignore) {
+    page_table_node_t* furthest = heap_peek_min(heap);
+    if (furthest && furthest->pid == ignore) {
+        /* Without the root, the furthest page table is one of its children */
+        furthest = heap_peek_second(heap);
+    }
+    return furthest;
+}
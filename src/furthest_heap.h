@@ -0,0 +1,28 @@
+/**
+ * Furthest heap module.
+ * A binary max heap of page tables keyed on the run their process is next used in, used by the OPT policy
+ * to find the process whose pages are needed furthest in the future in O(1) and to update it in O(log n).
+ * Built on the generic heap.
+ */
+
+#ifndef SCHEDULER_FURTHEST_HEAP_H
+#define SCHEDULER_FURTHEST_HEAP_H
+
+#include <stdlib.h>
+#include <assert.h>
+#include <stdbool.h>
+#include "heap.h"
+
+struct page_table_node;
+
+/* page tables with resident pages, each page table stores its position in furthest_index */
+typedef heap_t furthest_heap_t;
+
+furthest_heap_t* create_furthest_heap();
+void free_furthest_heap(furthest_heap_t* heap);
+void furthest_heap_insert(furthest_heap_t* heap, struct page_table_node* page_table);
+void furthest_heap_remove(furthest_heap_t* heap, struct page_table_node* page_table);
+void furthest_heap_update(furthest_heap_t* heap, struct page_table_node* page_table);
+struct page_table_node* furthest_heap_max(furthest_heap_t* heap, long long int ignore);
+
+#endif //SCHEDULER_FURTHEST_HEAP_H
@@ -0,0 +1,222 @@
+/**
+ * Generation index module
+ * Each generation is a list linked through arrays indexed by frame, so merging two generations is a splice.
+ */
+
+#include "generation_index.h"
+
+static generation_list_t* list_of(generation_index_t* index, long long int seq) {
+    return &index->lists[seq % MGLRU_GENERATIONS];
+}
+
+/**
+ * Append a frame to the list of a generation
+ * @param index
+ * @param seq
+ * @param frame_number
+ */
+static void push_frame(generation_index_t* index, long long int seq, long long int frame_number) {
+    generation_list_t* list = list_of(index, seq);
+    index->listed_seq[frame_number] = seq;
+    index->prev[frame_number] = list->tail;
+    index->next[frame_number] = -1;
+    if (list->tail >= 0) {
+        index->next[list->tail] = frame_number;
+    } else {
+        list->head = frame_number;
+    }
+    list->tail = frame_number;
+}
+
+/**
+ * Returns the generation a frame is listed in. Frames listed in merged generations are in the oldest one.
+ * @param index
+ * @param frame_number
+ * @return
+ */
+static long long int listed_in(generation_index_t* index, long long int frame_number) {
+    long long int seq = index->listed_seq[frame_number];
+    return seq > index->min_seq ? seq : index->min_seq;
+}
+
+/**
+ * Unlink a frame from the list of its generation
+ * @param index
+ * @param frame_number
+ */
+static void unlink_frame(generation_index_t* index, long long int frame_number) {
+    generation_list_t* list = list_of(index, listed_in(index, frame_number));
+    if (index->prev[frame_number] >= 0) {
+        index->next[index->prev[frame_number]] = index->next[frame_number];
+    } else {
+        list->head = index->next[frame_number];
+    }
+    if (index->next[frame_number] >= 0) {
+        index->prev[index->next[frame_number]] = index->prev[frame_number];
+    } else {
+        list->tail = index->prev[frame_number];
+    }
+    index->listed_seq[frame_number] = -1;
+}
+
+/**
+ * Merge the oldest generation into the next one, ahead of its own frames.
+ * Frames keep their listed generation, which is treated as the oldest from then on.
+ * @param index
+ */
+static void merge_oldest(generation_index_t* index) {
+    assert(index->min_seq < index->max_seq);
+    generation_list_t* oldest = list_of(index, index->min_seq);
+    generation_list_t* next = list_of(index, index->min_seq + 1);
+    if (oldest->head >= 0) {
+        if (next->head >= 0) {
+            index->next[oldest->tail] = next->head;
+            index->prev[next->head] = oldest->tail;
+        } else {
+            next->tail = oldest->tail;
+        }
+        next->head = oldest->head;
+    }
+    oldest->head = -1;
+    oldest->tail = -1;
+    index->min_seq++;
+}
+
+/**
+ * Open a new youngest generation
+ * @param index
+ */
+static void age(generation_index_t* index) {
+    if (index->max_seq - index->min_seq + 1 == MGLRU_GENERATIONS) {
+        merge_oldest(index);
+    }
+    index->max_seq++;
+}
+
+/**
+ * Create a generation index with no frames in it
+ * @param frame_count
+ * @return
+ */
+generation_index_t* create_generation_index(long long int frame_count) {
+    generation_index_t* index = malloc(sizeof(*index));
+    assert(index);
+    index->frame_count = frame_count;
+    index->min_seq = 0;
+    index->max_seq = 0;
+    for (int i=0; i<MGLRU_GENERATIONS; i++) {
+        index->lists[i].head = -1;
+        index->lists[i].tail = -1;
+    }
+    index->prev = malloc(sizeof(*index->prev) * (frame_count + 1));
+    index->next = malloc(sizeof(*index->next) * (frame_count + 1));
+    index->listed_seq = malloc(sizeof(*index->listed_seq) * (frame_count + 1));
+    index->seq = malloc(sizeof(*index->seq) * (frame_count + 1));
+    assert(index->prev && index->next && index->listed_seq && index->seq);
+    for (long long int i=0; i<frame_count; i++) {
+        index->listed_seq[i] = -1;
+        index->seq[i] = -1;
+    }
+    index->aged_at = 0;
+    return index;
+}
+
+/**
+ * Free a generation index
+ * @param index
+ */
+void free_generation_index(generation_index_t* index) {
+    assert(index);
+    free(index->prev);
+    free(index->next);
+    free(index->listed_seq);
+    free(index->seq);
+    free(index);
+}
+
+/**
+ * Add a frame that a page has just been loaded into, to the youngest generation
+ * @param index
+ * @param frame_number
+ */
+void generation_index_insert(generation_index_t* index, long long int frame_number) {
+    assert(index->listed_seq[frame_number] < 0);
+    push_frame(index, index->max_seq, frame_number);
+    index->seq[frame_number] = index->max_seq;
+}
+
+/**
+ * Remove a frame that is no longer occupied
+ * @param index
+ * @param frame_number
+ */
+void generation_index_remove(generation_index_t* index, long long int frame_number) {
+    if (index->listed_seq[frame_number] >= 0) {
+        unlink_frame(index, frame_number);
+        index->seq[frame_number] = -1;
+    }
+}
+
+/**
+ * Record a reference to a frame, which puts it in the youngest generation
+ * @param index
+ * @param frame_number
+ */
+void generation_index_reference(generation_index_t* index, long long int frame_number) {
+    index->seq[frame_number] = index->max_seq;
+}
+
+/**
+ * Age the generations once for every MGLRU_AGING_INTERVAL ticks passed up to the given tick.
+ * Aging as many times as there are generations merges every frame into the oldest one, so no more is needed.
+ * @param index
+ * @param clock
+ */
+void generation_index_advance(generation_index_t* index, long long int clock) {
+    long long int intervals = (clock - index->aged_at) / MGLRU_AGING_INTERVAL;
+    if (intervals <= 0) {
+        return;
+    }
+    index->aged_at += intervals * MGLRU_AGING_INTERVAL;
+    for (long long int i=0; i<intervals && i<MGLRU_GENERATIONS; i++) {
+        age(index);
+    }
+}
+
+/**
+ * Returns a frame to evict from the oldest generation, not owned by the given pid.
+ * Frames referenced since they were listed are moved to the generation they were referenced in on the way,
+ * and frames of the ignored process are moved to the next generation.
+ * Every frame is listed no younger than the youngest generation, so one pass over the generations
+ * reaches every frame that can be evicted.
+ * @param index
+ * @param owners the pid owning each frame
+ * @param ignore
+ * @return -1 if every occupied frame is owned by the ignored pid
+ */
+long long int generation_index_oldest(generation_index_t* index, long long int* owners, long long int ignore) {
+    for (int pass=0; pass<MGLRU_GENERATIONS; pass++) {
+        /* Keep a younger generation to move referenced frames into */
+        if (index->min_seq == index->max_seq) {
+            index->max_seq++;
+        }
+        generation_list_t* oldest = list_of(index, index->min_seq);
+        while (oldest->head >= 0) {
+            long long int frame_number = oldest->head;
+            assert(listed_in(index, frame_number) == index->min_seq);
+            if (index->seq[frame_number] > index->min_seq) {
+                unlink_frame(index, frame_number);
+                push_frame(index, index->seq[frame_number], frame_number);
+            } else if (owners[frame_number] == ignore) {
+                unlink_frame(index, frame_number);
+                index->seq[frame_number] = index->min_seq + 1;
+                push_frame(index, index->min_seq + 1, frame_number);
+            } else {
+                return frame_number;
+            }
+        }
+        /* The oldest generation is empty */
+        index->min_seq++;
+    }
+    return -1;
+}
@@ -0,0 +1,48 @@
+/**
+ * Generation index module.
+ * Keeps occupied frames in a few generations for the multi-generational LRU policy, after the Linux reclaim
+ * of the same name. Referencing a frame only stamps it with the youngest generation, and aging opens a new
+ * generation, merging the two oldest when every generation is in use, so both are O(1). Frames are moved to
+ * the generation they were stamped with when eviction reaches them in the oldest generation.
+ */
+
+#ifndef SCHEDULER_GENERATION_INDEX_H
+#define SCHEDULER_GENERATION_INDEX_H
+
+#include <stdlib.h>
+#include <assert.h>
+#include <stdbool.h>
+#include "constants.h"
+
+typedef struct generation_list {
+    /* Least recently added end */
+    long long int head;
+    /* Most recently added end */
+    long long int tail;
+} generation_list_t;
+
+typedef struct generation_index {
+    long long int frame_count;
+    /* Sequence numbers of the oldest and youngest generations, generation s is kept in lists[s % MGLRU_GENERATIONS] */
+    long long int min_seq;
+    long long int max_seq;
+    generation_list_t lists[MGLRU_GENERATIONS];
+    long long int* prev;
+    long long int* next;
+    /* The generation each frame is listed in, -1 if the frame is not occupied */
+    long long int* listed_seq;
+    /* The generation each frame was last referenced in, at least its listed generation */
+    long long int* seq;
+    /* The tick of the latest aging */
+    long long int aged_at;
+} generation_index_t;
+
+generation_index_t* create_generation_index(long long int frame_count);
+void free_generation_index(generation_index_t* index);
+void generation_index_insert(generation_index_t* index, long long int frame_number);
+void generation_index_remove(generation_index_t* index, long long int frame_number);
+void generation_index_reference(generation_index_t* index, long long int frame_number);
+void generation_index_advance(generation_index_t* index, long long int clock);
+long long int generation_index_oldest(generation_index_t* index, long long int* owners, long long int ignore);
+
+#endif //SCHEDULER_GENERATION_INDEX_H
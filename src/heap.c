@@ -2,7 +2,9 @@
 #include <stdlib.h>
 #include "heap.h"
 /*
- Array Implementation of MinHeap data Structure
+ Array Implementation of MinHeap data Structure.
+ Holds pointers, so a sift moves pointers rather than whole elements,
+ and sifts are loops rather than recursive calls.
 */
 
 int heap_size(heap_t* heap) {
@@ -10,100 +12,209 @@ int heap_size(heap_t* heap) {
 }
 
 heap_t *create_heap(int capacity, int (*cmp)(void *, void *)){
-    heap_t *h = (heap_t * ) malloc(sizeof(*h)); //one is number of heap
+    return create_d_ary_heap(capacity, 2, cmp, HEAP_NO_INDEX);
+}
 
-    //check if memory allocation is fails
-    if(h == NULL){
-        printf("Memory Error!");
-        return NULL;
-    }
+/**
+ * Create a heap with the given number of children per node
+ * @param capacity initial capacity, the heap grows as needed
+ * @param arity
+ * @param cmp
+ * @param index_offset offset of the position field of the elements, HEAP_NO_INDEX if they have none
+ * @return
+ */
+heap_t *create_d_ary_heap(int capacity, int arity, int (*cmp)(void *, void *), ptrdiff_t index_offset){
+    assert(arity >= 2);
+    heap_t *h = (heap_t * ) malloc(sizeof(*h));
+    assert(h);
     h->count=0;
-    h->capacity = capacity;
-    h->arr = (data *) malloc(capacity*sizeof(data)); //size in bytes
+    h->capacity = capacity > 0 ? capacity : 1;
+    h->arity = arity;
+    h->index_offset = index_offset;
+    h->arr = (void **) malloc(h->capacity*sizeof(*h->arr));
+    assert(h->arr);
     h->cmp = cmp;
-    //check if allocation succeed
-    if ( h->arr == NULL){
-        printf("Memory Error!");
-        return NULL;
-    }
     return h;
 }
 
-void heap_insert(heap_t *h, data key){
-    if( h->count < h->capacity){
-        h->arr[h->count] = key;
-        heapify_bottom_top(h, h->count);
-        h->count++;
-    }
+/**
+ * Returns the position field of an element
+ * @param h
+ * @param key
+ * @return
+ */
+static long long int *index_of(heap_t *h, void *key) {
+    assert(h->index_offset != HEAP_NO_INDEX);
+    return (long long int *)((char *)key + h->index_offset);
 }
 
+/**
+ * Store a key at a position, keeping its position field up to date
+ * @param h
+ * @param index
+ * @param key
+ */
+static void place(heap_t *h, int index, void *key) {
+    h->arr[index] = key;
+    if (h->index_offset != HEAP_NO_INDEX) {
+        *index_of(h, key) = index;
+    }
+}
 
+/**
+ * Move the key at index towards the root while its parent is greater
+ * @param h
+ * @param index
+ * @return the final position of the key
+ */
+static int sift_up(heap_t *h, int index) {
+    void *key = h->arr[index];
+    while (index > 0) {
+        int parent = (index - 1) / h->arity;
+        if (h->cmp(h->arr[parent], key) <= 0) {
+            break;
+        }
+        place(h, index, h->arr[parent]);
+        index = parent;
+    }
+    place(h, index, key);
+    return index;
+}
 
-void heapify_bottom_top(heap_t *h,int index){
-    data temp;
-    int parent_node = (index-1)/2;
-
-    if (h->cmp(&(h->arr[parent_node]), &(h->arr[index])) > 0){
-        //swap and recursive call
-        temp = h->arr[parent_node];
-        h->arr[parent_node] = h->arr[index];
-        h->arr[index] = temp;
-        heapify_bottom_top(h,parent_node);
+/**
+ * Move the key at index towards the leaves while a child is smaller.
+ * The first of equally small children is taken.
+ * @param h
+ * @param index
+ */
+static void sift_down(heap_t *h, int index) {
+    void *key = h->arr[index];
+    while (1) {
+        int first = index * h->arity + 1;
+        int last = first + h->arity < h->count ? first + h->arity : h->count;
+        void *min = key;
+        int min_index = index;
+        for (int child = first; child < last; child++) {
+            if (h->cmp(h->arr[child], min) < 0) {
+                min = h->arr[child];
+                min_index = child;
+            }
+        }
+        if (min_index == index) {
+            break;
+        }
+        place(h, index, min);
+        index = min_index;
     }
+    place(h, index, key);
 }
 
-void heapify_top_bottom(heap_t *h, int parent_node){
-    int left = parent_node*2+1;
-    int right = parent_node*2+2;
-    int min;
-    data temp;
+/**
+ * Returns the position of an element in the heap
+ * @param h
+ * @param key
+ * @return
+ */
+static int position_of(heap_t *h, void *key) {
+    long long int index = *index_of(h, key);
+    assert(index >= 0 && index < h->count && h->arr[index] == key);
+    return (int)index;
+}
 
-    if(left >= h->count || left <0)
-        left = -1;
-    if(right >= h->count || right <0)
-        right = -1;
+void heap_insert(heap_t *h, void *key){
+    if (h->count == h->capacity) {
+        // double the capacity when full
+        h->capacity *= 2;
+        h->arr = (void **) realloc(h->arr, h->capacity * sizeof(*h->arr));
+        assert(h->arr);
+    }
+    h->arr[h->count] = key;
+    h->count++;
+    sift_up(h, h->count - 1);
+}
 
-    if(left != -1 && h->cmp(&h->arr[left], &h->arr[parent_node]) < 0) {
-        min=left;
+void *heap_pop_min(heap_t *h){
+    assert(h->count > 0);
+    // replace first node by last and delete last
+    void *pop = h->arr[0];
+    h->count--;
+    if (h->count > 0) {
+        h->arr[0] = h->arr[h->count];
+        sift_down(h, 0);
     }
-    else {
-        min = parent_node;
+    if (h->index_offset != HEAP_NO_INDEX) {
+        *index_of(h, pop) = -1;
     }
-    if(right != -1 && h->cmp(&h->arr[right], &h->arr[min]) < 0)
-        min = right;
+    return pop;
+}
 
-    if(min != parent_node){
-        temp = h->arr[min];
-        h->arr[min] = h->arr[parent_node];
-        h->arr[parent_node] = temp;
+/**
+ * Returns the smallest key without removing it
+ * @param h
+ * @return NULL if the heap is empty
+ */
+void *heap_peek_min(heap_t *h) {
+    return h->count > 0 ? h->arr[0] : NULL;
+}
 
-        // recursive  call
-        heapify_top_bottom(h, min);
+/**
+ * Returns the smallest key other than the minimum, which is one of the children of the root
+ * @param h
+ * @return NULL if the heap has fewer than two keys
+ */
+void *heap_peek_second(heap_t *h) {
+    void *second = NULL;
+    int last = 1 + h->arity < h->count ? 1 + h->arity : h->count;
+    for (int child = 1; child < last; child++) {
+        if (!second || h->cmp(h->arr[child], second) < 0) {
+            second = h->arr[child];
+        }
     }
+    return second;
 }
 
-data heap_pop_min(heap_t *h){
-    data pop;
-    if(h->count==0){
-        printf("\n__Heap is Empty__\n");
+/**
+ * Remove an element that keeps its position from anywhere in the heap
+ * @param h
+ * @param key
+ */
+void heap_remove(heap_t *h, void *key) {
+    int index = position_of(h, key);
+    *index_of(h, key) = -1;
+    void *last = h->arr[--h->count];
+    if (last != key) {
+        place(h, index, last);
+        sift_down(h, sift_up(h, index));
     }
-    // replace first node by last and delete last
-    pop = h->arr[0];
-    h->arr[0] = h->arr[h->count-1];
-    h->count--;
-    heapify_top_bottom(h, 0);
-    return pop;
+}
+
+/**
+ * Restore the heap order after the key of an element has been lowered
+ * @param h
+ * @param key
+ */
+void heap_decrease_key(heap_t *h, void *key) {
+    sift_up(h, position_of(h, key));
+}
+
+/**
+ * Restore the heap order after the key of an element has changed either way
+ * @param h
+ * @param key
+ */
+void heap_update_key(heap_t *h, void *key) {
+    sift_down(h, sift_up(h, position_of(h, key)));
 }
 
 
 void heap_print(heap_t *h, void (*print)(void *)){
     int i;
     for(i=0;i< h->count;i++){
-        print(&h->arr[i]);
+        print(h->arr[i]);
     }
 }
 
 void free_heap(heap_t *h) {
     free(h->arr);
     free(h);
-}
\ No newline at end of file
+}
@@ -8,21 +8,36 @@
 
 #include <stdlib.h>
 #include <stdio.h>
-#include "process.h"
-typedef process_t data;
+#include <stddef.h>
+#include <assert.h>
 
+/* Index offset of a heap whose elements do not keep their position */
+#define HEAP_NO_INDEX (-1)
+
+/*
+ * Min heap of pointers, ordered by cmp. An element may keep its position in the heap in a long long int
+ * field at index_offset, which makes removing it or changing its key O(log n).
+ */
 typedef struct Heap{
-    data *arr;
+    void **arr;
     int count;
     int capacity;
+    /* Children per node, 2 for a binary heap */
+    int arity;
+    ptrdiff_t index_offset;
     int (*cmp)(void *, void *);
 } heap_t;
-//typedef process_t data;
-void heapify_bottom_top(heap_t *h,int index);
+
 heap_t *create_heap(int capacity, int (*cmp)(void *, void *));
-void heap_insert(heap_t *h, data key);
+heap_t *create_d_ary_heap(int capacity, int arity, int (*cmp)(void *, void *), ptrdiff_t index_offset);
+void heap_insert(heap_t *h, void *key);
 void heap_print(heap_t *h, void (*print)(void *));
-data heap_pop_min(heap_t *h);
+void *heap_pop_min(heap_t *h);
+void *heap_peek_min(heap_t *h);
+void *heap_peek_second(heap_t *h);
+void heap_remove(heap_t *h, void *key);
+void heap_decrease_key(heap_t *h, void *key);
+void heap_update_key(heap_t *h, void *key);
 int heap_size(heap_t* heap);
 void free_heap(heap_t *h);
 #endif //HEAP_H
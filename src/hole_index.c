@@ -0,0 +1,217 @@
+/**
+ * Hole index module
+ * Treap of holes in address order, augmented with the largest page length per subtree.
+ */
+
+#include "hole_index.h"
+
+/**
+ * Pseudo random priorities for the treap, deterministic across runs
+ * @return
+ */
+static unsigned int next_priority() {
+    static unsigned int state = 2463534242u;
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+static long long int max_of(long long int a, long long int b) {
+    return a > b ? a : b;
+}
+
+/**
+ * Order of holes in the index, which follows their order in the memory list
+ * @param node
+ * @param byte_start
+ * @param empty
+ * @param hole
+ * @return
+ */
+static int compare_hole(hole_index_node_t* node, long long int byte_start, bool empty, Node* hole) {
+    if (byte_start != node->byte_start) {
+        return byte_start < node->byte_start ? -1 : 1;
+    }
+    if (empty != node->empty) {
+        return empty ? -1 : 1;
+    }
+    if (hole != node->hole) {
+        return hole < node->hole ? -1 : 1;
+    }
+    return 0;
+}
+
+/**
+ * Recompute the largest page length of a subtree from its children
+ * @param node
+ */
+static void pull(hole_index_node_t* node) {
+    node->max_page_length = node->page_length;
+    if (node->left) {
+        node->max_page_length = max_of(node->max_page_length, node->left->max_page_length);
+    }
+    if (node->right) {
+        node->max_page_length = max_of(node->max_page_length, node->right->max_page_length);
+    }
+}
+
+static hole_index_node_t* rotate_right(hole_index_node_t* node) {
+    hole_index_node_t* left = node->left;
+    node->left = left->right;
+    left->right = node;
+    pull(node);
+    pull(left);
+    return left;
+}
+
+static hole_index_node_t* rotate_left(hole_index_node_t* node) {
+    hole_index_node_t* right = node->right;
+    node->right = right->left;
+    right->left = node;
+    pull(node);
+    pull(right);
+    return right;
+}
+
+static hole_index_node_t* insert_node(hole_index_node_t* root, hole_index_node_t* node) {
+    if (!root) {
+        return node;
+    }
+    int order = compare_hole(root, node->byte_start, node->empty, node->hole);
+    assert(order != 0);
+    if (order < 0) {
+        root->left = insert_node(root->left, node);
+        if (root->left->priority > root->priority) {
+            return rotate_right(root);
+        }
+    } else {
+        root->right = insert_node(root->right, node);
+        if (root->right->priority > root->priority) {
+            return rotate_left(root);
+        }
+    }
+    pull(root);
+    return root;
+}
+
+static hole_index_node_t* merge(hole_index_node_t* left, hole_index_node_t* right) {
+    if (!left) {
+        return right;
+    }
+    if (!right) {
+        return left;
+    }
+    if (left->priority > right->priority) {
+        left->right = merge(left->right, right);
+        pull(left);
+        return left;
+    }
+    right->left = merge(left, right->left);
+    pull(right);
+    return right;
+}
+
+static hole_index_node_t* remove_node(hole_index_node_t* root, long long int byte_start, bool empty, Node* hole) {
+    assert(root);
+    int order = compare_hole(root, byte_start, empty, hole);
+    if (order == 0) {
+        hole_index_node_t* merged = merge(root->left, root->right);
+        pool_free(root, sizeof(*root));
+        return merged;
+    }
+    if (order < 0) {
+        root->left = remove_node(root->left, byte_start, empty, hole);
+    } else {
+        root->right = remove_node(root->right, byte_start, empty, hole);
+    }
+    pull(root);
+    return root;
+}
+
+static void free_nodes(hole_index_node_t* root) {
+    if (root) {
+        free_nodes(root->left);
+        free_nodes(root->right);
+        pool_free(root, sizeof(*root));
+    }
+}
+
+/**
+ * Create an empty hole index
+ * @return
+ */
+hole_index_t* create_hole_index() {
+    hole_index_t* index = malloc(sizeof(*index));
+    assert(index);
+    index->root = NULL;
+    index->size = 0;
+    return index;
+}
+
+/**
+ * Free a hole index. The holes themselves are owned by the memory list.
+ * @param index
+ */
+void free_hole_index(hole_index_t* index) {
+    assert(index);
+    free_nodes(index->root);
+    free(index);
+}
+
+/**
+ * Add a hole to the index
+ * @param index
+ * @param hole
+ */
+void hole_index_insert(hole_index_t* index, Node* hole) {
+    memory_fragment_t* fragment = (memory_fragment_t*)hole->data;
+    assert(fragment->type == HOLE_FRAGMENT);
+    hole_index_node_t* node = pool_alloc(sizeof(*node));
+    assert(node);
+    node->byte_start = fragment->byte_start;
+    node->empty = fragment->byte_length == 0;
+    node->page_length = fragment->page_length;
+    node->max_page_length = fragment->page_length;
+    node->priority = next_priority();
+    node->hole = hole;
+    node->left = NULL;
+    node->right = NULL;
+    index->root = insert_node(index->root, node);
+    index->size++;
+}
+
+/**
+ * Remove a hole from the index.
+ * Must be called before the hole is resized, reused or freed.
+ * @param index
+ * @param hole
+ */
+void hole_index_remove(hole_index_t* index, Node* hole) {
+    memory_fragment_t* fragment = (memory_fragment_t*)hole->data;
+    index->root = remove_node(index->root, fragment->byte_start, fragment->byte_length == 0, hole);
+    index->size--;
+}
+
+/**
+ * Find the hole with the lowest address that has at least the given number of pages
+ * @param index
+ * @param pages_required
+ * @return NULL if no hole is large enough
+ */
+Node* hole_index_first_fit(hole_index_t* index, long long int pages_required) {
+    hole_index_node_t* current = index->root;
+    if (!current || current->max_page_length < pages_required) {
+        return NULL;
+    }
+    while (current) {
+        if (current->left && current->left->max_page_length >= pages_required) {
+            current = current->left;
+        } else if (current->page_length >= pages_required) {
+            return current->hole;
+        } else {
+            current = current->right;
+        }
+    }
+    return NULL;
+}
@@ -0,0 +1,44 @@
+/**
+ * Hole index module.
+ * An address ordered treap of hole fragments, where each subtree records the largest hole in it,
+ * so that the hole with the lowest address that fits a request can be found in O(log n).
+ */
+
+#ifndef SCHEDULER_HOLE_INDEX_H
+#define SCHEDULER_HOLE_INDEX_H
+
+#include <stdlib.h>
+#include <assert.h>
+#include <stdbool.h>
+#include "dlist.h"
+#include "memory_fragment.h"
+
+typedef struct hole_index_node hole_index_node_t;
+
+struct hole_index_node {
+    /* Holes are ordered by byte start. Empty holes may share their start with the next hole,
+     * so they are ordered first, as in the memory list */
+    long long int byte_start;
+    bool empty;
+    long long int page_length;
+    /* the largest page length within this subtree */
+    long long int max_page_length;
+    unsigned int priority;
+    /* list node containing the hole fragment */
+    Node* hole;
+    hole_index_node_t* left;
+    hole_index_node_t* right;
+};
+
+typedef struct hole_index {
+    hole_index_node_t* root;
+    long long int size;
+} hole_index_t;
+
+hole_index_t* create_hole_index();
+void free_hole_index(hole_index_t* index);
+void hole_index_insert(hole_index_t* index, Node* hole);
+void hole_index_remove(hole_index_t* index, Node* hole);
+Node* hole_index_first_fit(hole_index_t* index, long long int pages_required);
+
+#endif //SCHEDULER_HOLE_INDEX_H
@@ -0,0 +1,179 @@
+/**
+ * LFU index module
+ * Ties between equal counters go to the lowest frame number.
+ */
+
+#include "lfu_index.h"
+
+#define LFU_INDEX_INITIAL_CAPACITY 16
+
+/**
+ * Returns the number of aging ticks until a counter reaches 0
+ * @param counter
+ * @return
+ */
+static long long int ticks_to_zero(unsigned int counter) {
+    return counter ? 32 - __builtin_clz(counter) : 0;
+}
+
+/**
+ * Returns the value of a counter after the aging it is owed
+ * @param counter
+ * @param aged_at
+ * @param epoch
+ * @return
+ */
+static unsigned int aged_counter(unsigned int counter, long long int aged_at, long long int epoch) {
+    long long int owed = epoch - aged_at;
+    return counter >> (owed < MAX_AGING_SHIFT ? owed : MAX_AGING_SHIFT);
+}
+
+static void push_due(lfu_index_t* index, long long int frame_number, long long int zero_at) {
+    int slot = (int)(zero_at % LFU_INDEX_SLOTS);
+    if (index->due_count[slot] == index->due_capacity[slot]) {
+        index->due_capacity[slot] *= 2;
+        index->due[slot] = realloc(index->due[slot], sizeof(*index->due[slot]) * index->due_capacity[slot]);
+        assert(index->due[slot]);
+    }
+    index->due[slot][index->due_count[slot]++] = frame_number;
+}
+
+/**
+ * Returns if a frame is occupied and its counter has not reached 0 by epoch
+ * @param index
+ * @param frame_number
+ * @param epoch
+ * @return
+ */
+static bool is_counting_down(lfu_index_t* index, long long int frame_number, long long int epoch) {
+    return index->zero_at[frame_number] > epoch && !frame_bitmap_test(index->idle_frames, frame_number);
+}
+
+/**
+ * Create an index where no frame is occupied
+ * @param frame_count
+ * @return
+ */
+lfu_index_t* create_lfu_index(long long int frame_count) {
+    lfu_index_t* index = malloc(sizeof(*index));
+    assert(index);
+    index->frame_count = frame_count;
+    index->idle_frames = create_frame_bitmap(frame_count, false);
+    index->zero_at = malloc(sizeof(*index->zero_at) * (frame_count > 0 ? frame_count : 1));
+    assert(index->zero_at);
+    for (long long int i=0; i<frame_count; i++) {
+        index->zero_at[i] = -1;
+    }
+    for (int slot=0; slot<LFU_INDEX_SLOTS; slot++) {
+        index->due_count[slot] = 0;
+        index->due_capacity[slot] = LFU_INDEX_INITIAL_CAPACITY;
+        index->due[slot] = malloc(sizeof(*index->due[slot]) * index->due_capacity[slot]);
+        assert(index->due[slot]);
+    }
+    return index;
+}
+
+/**
+ * Free an LFU index
+ * @param index
+ */
+void free_lfu_index(lfu_index_t* index) {
+    assert(index);
+    free_frame_bitmap(index->idle_frames);
+    free(index->zero_at);
+    for (int slot=0; slot<LFU_INDEX_SLOTS; slot++) {
+        free(index->due[slot]);
+    }
+    free(index);
+}
+
+/**
+ * Record the counter of an occupied frame after it has been mapped or aged
+ * @param index
+ * @param frame_number
+ * @param counter value of the counter at aged_at
+ * @param aged_at
+ * @param epoch the current aging tick, no earlier than aged_at
+ */
+void lfu_index_track(lfu_index_t* index, long long int frame_number, unsigned int counter, long long int aged_at, long long int epoch) {
+    long long int zero_at = aged_at + ticks_to_zero(counter);
+    index->zero_at[frame_number] = zero_at;
+    if (zero_at <= epoch) {
+        frame_bitmap_set(index->idle_frames, frame_number);
+    } else {
+        frame_bitmap_clear(index->idle_frames, frame_number);
+        push_due(index, frame_number, zero_at);
+    }
+}
+
+/**
+ * Forget a frame that is no longer occupied
+ * @param index
+ * @param frame_number
+ */
+void lfu_index_untrack(lfu_index_t* index, long long int frame_number) {
+    index->zero_at[frame_number] = -1;
+    frame_bitmap_clear(index->idle_frames, frame_number);
+}
+
+/**
+ * Move frames whose counter reaches 0 between two aging ticks into the idle frames
+ * @param index
+ * @param from_epoch
+ * @param to_epoch
+ */
+void lfu_index_advance(lfu_index_t* index, long long int from_epoch, long long int to_epoch) {
+    long long int last = to_epoch - from_epoch < LFU_INDEX_SLOTS ? to_epoch : from_epoch + LFU_INDEX_SLOTS;
+    for (long long int epoch=from_epoch + 1; epoch<=last; epoch++) {
+        int slot = (int)(epoch % LFU_INDEX_SLOTS);
+        for (long long int i=0; i<index->due_count[slot]; i++) {
+            long long int frame_number = index->due[slot][i];
+            /* Skip frames aged again or freed since they were listed */
+            if (index->zero_at[frame_number] >= 0 && index->zero_at[frame_number] <= to_epoch
+                && !frame_bitmap_test(index->idle_frames, frame_number)) {
+                frame_bitmap_set(index->idle_frames, frame_number);
+            }
+        }
+        index->due_count[slot] = 0;
+    }
+}
+
+/**
+ * Find the occupied frame with the lowest counter, not owned by the ignored process
+ * @param index
+ * @param counters
+ * @param aged_at
+ * @param epoch
+ * @param owners pid of the process each frame belongs to
+ * @param ignore
+ * @return -1 if every occupied frame belongs to the ignored process
+ */
+long long int lfu_index_min(lfu_index_t* index, unsigned int* counters, long long int* aged_at, long long int epoch,
+                            long long int* owners, long long int ignore) {
+    /* A counter of 0 is the lowest possible, so the lowest idle frame wins */
+    long long int frame_number = frame_bitmap_lowest(index->idle_frames);
+    while (frame_number >= 0 && owners[frame_number] == ignore) {
+        frame_number = frame_bitmap_next(index->idle_frames, frame_number + 1);
+    }
+    if (frame_number >= 0) {
+        return frame_number;
+    }
+    /* Otherwise every candidate was aged within the last few ticks and is still listed */
+    long long int victim = -1;
+    unsigned int min_freq = 0;
+    for (int slot=0; slot<LFU_INDEX_SLOTS; slot++) {
+        for (long long int i=0; i<index->due_count[slot]; i++) {
+            long long int candidate = index->due[slot][i];
+            if (!is_counting_down(index, candidate, epoch) || index->zero_at[candidate] % LFU_INDEX_SLOTS != slot
+                || owners[candidate] == ignore) {
+                continue;
+            }
+            unsigned int freq = aged_counter(counters[candidate], aged_at[candidate], epoch);
+            if (victim < 0 || freq < min_freq || (freq == min_freq && candidate < victim)) {
+                victim = candidate;
+                min_freq = freq;
+            }
+        }
+    }
+    return victim;
+}
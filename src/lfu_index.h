@@ -0,0 +1,41 @@
+/**
+ * LFU index module.
+ * Indexes occupied frames by their aged frequency counter, so that LFU can find the frame with the
+ * lowest counter without scanning every frame. Counters age lazily (see constants.h): a counter
+ * that is not referenced reaches 0 within 8 aging ticks, after which it moves into a bitmap of idle
+ * frames. Frames still counting down are kept in a calendar of lists by the tick they reach 0.
+ */
+
+#ifndef SCHEDULER_LFU_INDEX_H
+#define SCHEDULER_LFU_INDEX_H
+
+#include <stdlib.h>
+#include <assert.h>
+#include <stdbool.h>
+#include "frame_bitmap.h"
+#include "constants.h"
+
+/* A counter reaches 0 at most MAX_AGING_SHIFT ticks ahead, so one more list than that never collides */
+#define LFU_INDEX_SLOTS (MAX_AGING_SHIFT + 1)
+
+typedef struct lfu_index {
+    long long int frame_count;
+    /* Occupied frames whose counter has aged to 0 */
+    frame_bitmap_t* idle_frames;
+    /* The aging tick each frame's counter reaches 0, -1 if the frame is not occupied */
+    long long int* zero_at;
+    /* Frames by zero_at modulo LFU_INDEX_SLOTS, may contain entries since superseded */
+    long long int* due[LFU_INDEX_SLOTS];
+    long long int due_count[LFU_INDEX_SLOTS];
+    long long int due_capacity[LFU_INDEX_SLOTS];
+} lfu_index_t;
+
+lfu_index_t* create_lfu_index(long long int frame_count);
+void free_lfu_index(lfu_index_t* index);
+void lfu_index_track(lfu_index_t* index, long long int frame_number, unsigned int counter, long long int aged_at, long long int epoch);
+void lfu_index_untrack(lfu_index_t* index, long long int frame_number);
+void lfu_index_advance(lfu_index_t* index, long long int from_epoch, long long int to_epoch);
+long long int lfu_index_min(lfu_index_t* index, unsigned int* counters, long long int* aged_at, long long int epoch,
+                            long long int* owners, long long int ignore);
+
+#endif //SCHEDULER_LFU_INDEX_H
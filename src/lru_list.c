@@ -0,0 +1,95 @@
+/**
+ * LRU list module
+ */
+
+#include "lru_list.h"
+
+/**
+ * Create an empty LRU list
+ * @param frame_count
+ * @return
+ */
+lru_list_t* create_lru_list(long long int frame_count) {
+    lru_list_t* list = malloc(sizeof(*list));
+    assert(list);
+    list->frame_count = frame_count;
+    list->head = -1;
+    list->tail = -1;
+    list->prev = malloc(sizeof(*list->prev) * (frame_count + 1));
+    list->next = malloc(sizeof(*list->next) * (frame_count + 1));
+    list->listed = calloc(frame_count + 1, sizeof(*list->listed));
+    assert(list->prev && list->next && list->listed);
+    return list;
+}
+
+/**
+ * Free an LRU list
+ * @param list
+ */
+void free_lru_list(lru_list_t* list) {
+    assert(list);
+    free(list->prev);
+    free(list->next);
+    free(list->listed);
+    free(list);
+}
+
+/**
+ * Remove a frame from the list, if it is in it
+ * @param list
+ * @param frame_number
+ */
+void lru_list_remove(lru_list_t* list, long long int frame_number) {
+    if (!list->listed[frame_number]) {
+        return;
+    }
+    if (list->prev[frame_number] >= 0) {
+        list->next[list->prev[frame_number]] = list->next[frame_number];
+    } else {
+        list->head = list->next[frame_number];
+    }
+    if (list->next[frame_number] >= 0) {
+        list->prev[list->next[frame_number]] = list->prev[frame_number];
+    } else {
+        list->tail = list->prev[frame_number];
+    }
+    list->listed[frame_number] = false;
+}
+
+/**
+ * Make a frame the most recently used, adding it to the list if needed
+ * @param list
+ * @param frame_number
+ */
+void lru_list_touch(lru_list_t* list, long long int frame_number) {
+    if (list->tail == frame_number) {
+        return;
+    }
+    lru_list_remove(list, frame_number);
+    list->prev[frame_number] = list->tail;
+    list->next[frame_number] = -1;
+    if (list->tail >= 0) {
+        list->next[list->tail] = frame_number;
+    } else {
+        list->head = frame_number;
+    }
+    list->tail = frame_number;
+    list->listed[frame_number] = true;
+}
+
+/**
+ * Returns the least recently used frame not owned by the given pid
+ * @param list
+ * @param owners the pid owning each frame
+ * @param ignore
+ * @return -1 if there is no such frame
+ */
+long long int lru_list_oldest(lru_list_t* list, long long int* owners, long long int ignore) {
+    /* The skipped frames belong to the process being allocated, which holds fewer frames than it needs to run */
+    for (long long int frame_number=list->head; frame_number >= 0; frame_number=list->next[frame_number]) {
+        if (owners[frame_number] != ignore) {
+            return frame_number;
+        }
+    }
+    return -1;
+}
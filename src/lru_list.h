@@ -0,0 +1,32 @@
+/**
+ * LRU list module.
+ * A recency list of occupied frames, linked through arrays indexed by frame, so that touching a frame
+ * moves it to the most recently used end in O(1) and the least recently used frame is at the head.
+ */
+
+#ifndef SCHEDULER_LRU_LIST_H
+#define SCHEDULER_LRU_LIST_H
+
+#include <stdlib.h>
+#include <assert.h>
+#include <stdbool.h>
+
+typedef struct lru_list {
+    long long int frame_count;
+    /* Least recently used frame, -1 if the list is empty */
+    long long int head;
+    /* Most recently used frame, -1 if the list is empty */
+    long long int tail;
+    long long int* prev;
+    long long int* next;
+    /* Whether each frame is in the list */
+    bool* listed;
+} lru_list_t;
+
+lru_list_t* create_lru_list(long long int frame_count);
+void free_lru_list(lru_list_t* list);
+void lru_list_touch(lru_list_t* list, long long int frame_number);
+void lru_list_remove(lru_list_t* list, long long int frame_number);
+long long int lru_list_oldest(lru_list_t* list, long long int* owners, long long int ignore);
+
+#endif //SCHEDULER_LRU_LIST_H
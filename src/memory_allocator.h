@@ -16,6 +16,9 @@ typedef struct memory_allocator {
     void (*use)(void*, process_t*, long long int);
     void (*free)(void*, process_t*, long long int);
     void (*load)(void*, process_t*);
+    /* Bulk versions of use and load, used to skip over ticks between events */
+    void (*use_ticks)(void*, process_t*, long long int, long long int);
+    void (*load_ticks)(void*, process_t*, long long int);
     long long int (*load_time_left)(void*, process_t*);
     long long int (*require_allocation)(void*, process_t*);
     long long int (*page_fault)(void*, process_t*);
@@ -8,7 +8,7 @@
 
 
 memory_fragment_t* create_hole_fragment(long long int byte_start, long long int page_start, long long int byte_length, long long int page_length) {
-    memory_fragment_t* fragment = (memory_fragment_t*)malloc(sizeof(*fragment));
+    memory_fragment_t* fragment = (memory_fragment_t*)pool_alloc(sizeof(*fragment));
     fragment->type = HOLE_FRAGMENT;
     fragment->byte_start = byte_start;
     fragment->page_start = page_start;
@@ -17,11 +17,12 @@ memory_fragment_t* create_hole_fragment(long long int byte_start, long long int
     fragment -> pid = -1;
     fragment->last_access = -1;
     fragment->load_time = -1;
+    fragment->recency_index = -1;
     return fragment;
 }
 
 memory_fragment_t* create_process_fragment(long long int byte_start, long long int page_start, long long int byte_length, long long int page_length, long long int pid) {
-    memory_fragment_t* fragment = (memory_fragment_t*)malloc(sizeof(*fragment));
+    memory_fragment_t* fragment = (memory_fragment_t*)pool_alloc(sizeof(*fragment));
     fragment->type = PROCESS_FRAGMENT;
     fragment->byte_start = byte_start;
     fragment->page_start = page_start;
@@ -30,6 +31,7 @@ memory_fragment_t* create_process_fragment(long long int byte_start, long long i
     fragment -> pid = pid;
     fragment->last_access= -1;
     fragment->load_time = page_length*LOADING_TIME_PER_PAGE;
+    fragment->recency_index = -1;
     return fragment;
 }
 
@@ -59,13 +61,11 @@ void log_fragment(memory_fragment_t* fragment) {
 
 void free_fragment(memory_fragment_t* fragment) {
     if (fragment) {
-        free(fragment);
+        pool_free(fragment, sizeof(*fragment));
     }
 }
 
 
 void dlist_free_fragment(void* fragment) {
-    if (fragment) {
-        free(fragment);
-    }
+    free_fragment((memory_fragment_t*)fragment);
 }
\ No newline at end of file
@@ -6,6 +6,7 @@
 #define COMP30023_2020_PROJECT_2_MEMORY_FRAGMENT_H
 
 #include "process.h"
+#include "dlist.h"
 #include <stdlib.h>
 #include <stdio.h>
 #include "constants.h"
@@ -20,6 +21,10 @@ typedef struct memory_fragment {
     long long int pid;
     long long int last_access;
     long long int load_time;
+    /* position in the recency heap of the memory list, -1 if not in it */
+    long long int recency_index;
+    /* Links of the fragment in the memory list, which is intrusive */
+    Node node;
 } memory_fragment_t;
 
 memory_fragment_t* create_hole_fragment(long long int byte_start, long long int page_start, long long int byte_length, long long int page_length);
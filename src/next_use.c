@@ -0,0 +1,121 @@
+/**
+ * Next use module
+ * Each process keeps its own sorted list of runs with a cursor at the runs it has started, so looking up
+ * its next run is O(1). Processes are matched by how many runs each has started rather than by the run count,
+ * so one process running more or less often than when recorded does not shift the runs of the others.
+ */
+
+#include "next_use.h"
+
+#define RUN_LIST_INITIAL_CAPACITY 4
+
+/**
+ * Returns the run list of a process, creating it if needed
+ * @param schedule
+ * @param pid
+ * @return
+ */
+static run_list_t* run_list_of(next_use_t* schedule, long long int pid) {
+    run_list_t* list = pid_map_get(schedule->run_lists, pid);
+    if (!list) {
+        list = malloc(sizeof(*list));
+        assert(list);
+        list->runs = NULL;
+        list->count = 0;
+        list->capacity = 0;
+        list->cursor = 0;
+        pid_map_put(schedule->run_lists, pid, list);
+    }
+    return list;
+}
+
+/**
+ * Create an empty schedule, ready to record runs
+ * @return
+ */
+next_use_t* create_next_use() {
+    next_use_t* schedule = malloc(sizeof(*schedule));
+    assert(schedule);
+    schedule->run_lists = create_pid_map();
+    schedule->run_count = 0;
+    schedule->last_pid = -1;
+    schedule->last_tick = LLONG_MIN;
+    schedule->recording = true;
+    return schedule;
+}
+
+/**
+ * Free a schedule and the runs recorded in it
+ * @param schedule
+ */
+void free_next_use(next_use_t* schedule) {
+    assert(schedule);
+    for (long long int i=0; i<schedule->run_lists->capacity; i++) {
+        if (schedule->run_lists->entries[i].used) {
+            run_list_t* list = schedule->run_lists->entries[i].value;
+            free(list->runs);
+            free(list);
+        }
+    }
+    free_pid_map(schedule->run_lists);
+    free(schedule);
+}
+
+/**
+ * Note that a process uses memory from tick start to tick end.
+ * A new run starts unless the same process used memory on the tick before.
+ * @param schedule
+ * @param pid
+ * @param start
+ * @param end
+ */
+void next_use_observe(next_use_t* schedule, long long int pid, long long int start, long long int end) {
+    if (pid != schedule->last_pid || start > schedule->last_tick + 1) {
+        schedule->run_count++;
+        run_list_t* list = run_list_of(schedule, pid);
+        if (schedule->recording) {
+            if (list->count == list->capacity) {
+                list->capacity = list->capacity ? list->capacity * 2 : RUN_LIST_INITIAL_CAPACITY;
+                list->runs = realloc(list->runs, sizeof(*list->runs) * list->capacity);
+                assert(list->runs);
+            }
+            list->runs[list->count++] = schedule->run_count;
+        }
+        list->cursor++;
+    }
+    schedule->last_pid = pid;
+    schedule->last_tick = end;
+}
+
+/**
+ * Returns when the next run of a process started in the recording
+ * @param schedule
+ * @param pid
+ * @return NEVER_USED if the process is not expected to run again, or runs are still being recorded
+ */
+long long int next_use_of(next_use_t* schedule, long long int pid) {
+    if (schedule->recording) {
+        return NEVER_USED;
+    }
+    run_list_t* list = pid_map_get(schedule->run_lists, pid);
+    if (!list) {
+        return NEVER_USED;
+    }
+    return list->cursor < list->count ? list->runs[list->cursor] : NEVER_USED;
+}
+
+/**
+ * Stop recording and start looking up runs from the beginning of the workload again
+ * @param schedule
+ */
+void next_use_replay(next_use_t* schedule) {
+    schedule->recording = false;
+    schedule->run_count = 0;
+    schedule->last_pid = -1;
+    schedule->last_tick = LLONG_MIN;
+    for (long long int i=0; i<schedule->run_lists->capacity; i++) {
+        if (schedule->run_lists->entries[i].used) {
+            ((run_list_t*)schedule->run_lists->entries[i].value)->cursor = 0;
+        }
+    }
+}
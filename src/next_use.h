@@ -0,0 +1,49 @@
+/**
+ * Next use module.
+ * Records the order processes run in during a first pass over a workload, then answers when each
+ * process runs next during a second pass, which is what the Belady OPT policy needs to know.
+ * Time is counted in runs, a run being the ticks one process uses memory in a row, since the
+ * ticks of the second pass drift from the first once the policies evict different pages.
+ * The next use of a process is when its next run started in the recording.
+ */
+
+#ifndef SCHEDULER_NEXT_USE_H
+#define SCHEDULER_NEXT_USE_H
+
+#include <stdlib.h>
+#include <assert.h>
+#include <stdbool.h>
+#include <limits.h>
+#include "pid_map.h"
+
+/* Next use of a process that does not run again */
+#define NEVER_USED LLONG_MAX
+
+typedef struct run_list {
+    /* Runs of a process in increasing order */
+    long long int* runs;
+    long long int count;
+    long long int capacity;
+    /* Runs the process has started, which is also the index of its next run */
+    long long int cursor;
+} run_list_t;
+
+typedef struct next_use {
+    /* Maps pid to its run_list_t */
+    pid_map_t* run_lists;
+    /* Runs started so far */
+    long long int run_count;
+    /* Process and tick of the latest use of memory */
+    long long int last_pid;
+    long long int last_tick;
+    /* Whether runs are being recorded, rather than looked up */
+    bool recording;
+} next_use_t;
+
+next_use_t* create_next_use();
+void free_next_use(next_use_t* schedule);
+void next_use_observe(next_use_t* schedule, long long int pid, long long int start, long long int end);
+long long int next_use_of(next_use_t* schedule, long long int pid);
+void next_use_replay(next_use_t* schedule);
+
+#endif //SCHEDULER_NEXT_USE_H
@@ -0,0 +1,153 @@
+/**
+ * Pid map module
+ * Linear probing with backward shift deletion, so no tombstones are needed.
+ */
+
+#include "pid_map.h"
+
+#define PID_MAP_INITIAL_CAPACITY 64
+
+/**
+ * Spread pids over the table, consecutive pids are common
+ * @param pid
+ * @return
+ */
+static unsigned long long hash_pid(long long int pid) {
+    unsigned long long x = (unsigned long long)pid;
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    return x;
+}
+
+static pid_map_entry_t* allocate_entries(long long int capacity) {
+    pid_map_entry_t* entries = calloc(capacity, sizeof(*entries));
+    assert(entries);
+    return entries;
+}
+
+/**
+ * Find the slot of a pid, or the empty slot where it would be inserted
+ * @param map
+ * @param pid
+ * @return
+ */
+static long long int find_slot(pid_map_t* map, long long int pid) {
+    long long int mask = map->capacity - 1;
+    long long int slot = (long long int)(hash_pid(pid) & mask);
+    while (map->entries[slot].used && map->entries[slot].pid != pid) {
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+/**
+ * Double the capacity and rehash all entries
+ * @param map
+ */
+static void grow(pid_map_t* map) {
+    pid_map_entry_t* old = map->entries;
+    long long int old_capacity = map->capacity;
+    map->capacity *= 2;
+    map->entries = allocate_entries(map->capacity);
+    for (long long int i=0; i<old_capacity; i++) {
+        if (old[i].used) {
+            map->entries[find_slot(map, old[i].pid)] = old[i];
+        }
+    }
+    free(old);
+}
+
+/**
+ * Create an empty pid map
+ * @return
+ */
+pid_map_t* create_pid_map() {
+    pid_map_t* map = malloc(sizeof(*map));
+    assert(map);
+    map->capacity = PID_MAP_INITIAL_CAPACITY;
+    map->size = 0;
+    map->entries = allocate_entries(map->capacity);
+    return map;
+}
+
+/**
+ * Free a pid map, values are not freed
+ * @param map
+ */
+void free_pid_map(pid_map_t* map) {
+    assert(map);
+    free(map->entries);
+    free(map);
+}
+
+/**
+ * Associate a pid with a value, replacing any previous value
+ * @param map
+ * @param pid
+ * @param value
+ */
+void pid_map_put(pid_map_t* map, long long int pid, void* value) {
+    /* Keep the load factor under 3/4 */
+    if ((map->size + 1) * 4 > map->capacity * 3) {
+        grow(map);
+    }
+    long long int slot = find_slot(map, pid);
+    if (!map->entries[slot].used) {
+        map->entries[slot].used = true;
+        map->entries[slot].pid = pid;
+        map->size++;
+    }
+    map->entries[slot].value = value;
+}
+
+/**
+ * Returns the value of a pid
+ * @param map
+ * @param pid
+ * @return NULL if the pid is not in the map
+ */
+void* pid_map_get(pid_map_t* map, long long int pid) {
+    long long int slot = find_slot(map, pid);
+    return map->entries[slot].used ? map->entries[slot].value : NULL;
+}
+
+/**
+ * Remove a pid from the map
+ * @param map
+ * @param pid
+ * @return the value removed, NULL if the pid is not in the map
+ */
+void* pid_map_remove(pid_map_t* map, long long int pid) {
+    long long int mask = map->capacity - 1;
+    long long int slot = find_slot(map, pid);
+    if (!map->entries[slot].used) {
+        return NULL;
+    }
+    void* value = map->entries[slot].value;
+    /* Shift following entries of the probe sequence back into the gap */
+    long long int gap = slot;
+    long long int next = (gap + 1) & mask;
+    while (map->entries[next].used) {
+        long long int home = (long long int)(hash_pid(map->entries[next].pid) & mask);
+        /* The entry can fill the gap if its home slot is not within (gap, next] */
+        if (((next - home) & mask) >= ((next - gap) & mask)) {
+            map->entries[gap] = map->entries[next];
+            gap = next;
+        }
+        next = (next + 1) & mask;
+    }
+    map->entries[gap].used = false;
+    map->entries[gap].value = NULL;
+    map->size--;
+    return value;
+}
+
+/**
+ * Returns the number of pids in the map
+ * @param map
+ * @return
+ */
+long long int pid_map_size(pid_map_t* map) {
+    return map->size;
+}
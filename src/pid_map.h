@@ -0,0 +1,33 @@
+/**
+ * Pid map module.
+ * An open addressing hash map from pid to a pointer, used by memory allocators to find a process's memory in O(1).
+ */
+
+#ifndef SCHEDULER_PID_MAP_H
+#define SCHEDULER_PID_MAP_H
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <assert.h>
+
+typedef struct pid_map_entry {
+    long long int pid;
+    void* value;
+    bool used;
+} pid_map_entry_t;
+
+typedef struct pid_map {
+    pid_map_entry_t* entries;
+    /* Always a power of two */
+    long long int capacity;
+    long long int size;
+} pid_map_t;
+
+pid_map_t* create_pid_map();
+void free_pid_map(pid_map_t* map);
+void pid_map_put(pid_map_t* map, long long int pid, void* value);
+void* pid_map_get(pid_map_t* map, long long int pid);
+void* pid_map_remove(pid_map_t* map, long long int pid);
+long long int pid_map_size(pid_map_t* map);
+
+#endif //SCHEDULER_PID_MAP_H
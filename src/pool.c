@@ -0,0 +1,108 @@
+/**
+ * Pool module
+ * Freed objects are kept in a free list per size class, linked through their first bytes.
+ */
+
+#include "pool.h"
+
+#define POOL_CLASS_COUNT (POOL_MAX_SIZE / POOL_SIZE_CLASS)
+
+typedef struct pool_chunk pool_chunk_t;
+
+struct pool_chunk {
+    pool_chunk_t* next;
+    /* Keep the objects that follow aligned to the size class */
+    char padding[POOL_SIZE_CLASS - sizeof(pool_chunk_t*)];
+};
+
+typedef struct pool_class {
+    void* free_list;
+    /* The part of the latest chunk not handed out yet */
+    char* unused;
+    char* unused_end;
+} pool_class_t;
+
+static pool_class_t classes[POOL_CLASS_COUNT];
+static pool_chunk_t* chunks = NULL;
+
+/**
+ * Returns the index of the size class of an object size
+ * @param size
+ * @return
+ */
+static size_t class_of(size_t size) {
+    return size == 0 ? 0 : (size - 1) / POOL_SIZE_CLASS;
+}
+
+/**
+ * Give a size class a new chunk to carve objects from
+ * @param pool
+ */
+static void grow(pool_class_t* pool) {
+    pool_chunk_t* chunk = malloc(sizeof(*chunk) + POOL_CHUNK_SIZE);
+    assert(chunk);
+    chunk->next = chunks;
+    chunks = chunk;
+    pool->unused = (char*)(chunk + 1);
+    pool->unused_end = pool->unused + POOL_CHUNK_SIZE;
+}
+
+/**
+ * Allocate an object, from its size class pool if it is small enough
+ * @param size
+ * @return
+ */
+void* pool_alloc(size_t size) {
+    if (size > POOL_MAX_SIZE) {
+        void* object = malloc(size);
+        assert(object);
+        return object;
+    }
+    pool_class_t* pool = &classes[class_of(size)];
+    if (pool->free_list) {
+        void* object = pool->free_list;
+        pool->free_list = *(void**)object;
+        return object;
+    }
+    size_t rounded = (class_of(size) + 1) * POOL_SIZE_CLASS;
+    if (!pool->unused || pool->unused_end - pool->unused < (ptrdiff_t)rounded) {
+        grow(pool);
+    }
+    void* object = pool->unused;
+    pool->unused += rounded;
+    return object;
+}
+
+/**
+ * Return an object to its pool
+ * @param object
+ * @param size the size the object was allocated with
+ */
+void pool_free(void* object, size_t size) {
+    if (!object) {
+        return;
+    }
+    if (size > POOL_MAX_SIZE) {
+        free(object);
+        return;
+    }
+    pool_class_t* pool = &classes[class_of(size)];
+    *(void**)object = pool->free_list;
+    pool->free_list = object;
+}
+
+/**
+ * Release every chunk of every pool. Objects allocated from the pools must not be used afterwards.
+ */
+void pool_release_all() {
+    while (chunks) {
+        pool_chunk_t* next = chunks->next;
+        free(chunks);
+        chunks = next;
+    }
+    for (size_t i=0; i<POOL_CLASS_COUNT; i++) {
+        classes[i].free_list = NULL;
+        classes[i].unused = NULL;
+        classes[i].unused_end = NULL;
+    }
+}
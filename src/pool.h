@@ -0,0 +1,26 @@
+/**
+ * Pool module.
+ * Size class pools for the small records the simulation creates and destroys all the time, such as list nodes,
+ * processes, memory fragments and page tables. Each size class carves objects out of large chunks and keeps
+ * freed objects for reuse, so once the pools have grown the simulation stops calling malloc and free.
+ * Every chunk is released at once when the simulation is torn down.
+ */
+
+#ifndef SCHEDULER_POOL_H
+#define SCHEDULER_POOL_H
+
+#include <stdlib.h>
+#include <stddef.h>
+#include <assert.h>
+
+/* Objects are rounded up to a multiple of this, which is also their alignment */
+#define POOL_SIZE_CLASS 16
+/* Larger objects are left to malloc */
+#define POOL_MAX_SIZE 256
+#define POOL_CHUNK_SIZE (64 * 1024)
+
+void* pool_alloc(size_t size);
+void pool_free(void* object, size_t size);
+void pool_release_all();
+
+#endif //SCHEDULER_POOL_H
@@ -17,7 +17,7 @@ void output_finish(long long int clock, process_t* process, long long int proc_r
  * @return
  */
 process_t* create_process(long long int timeArrived, long long int pid, long long int memory, long long int job_time) {
-    process_t* newProcess = (process_t*)malloc(sizeof(*newProcess));
+    process_t* newProcess = (process_t*)pool_alloc(sizeof(*newProcess));
     if (newProcess == NULL) {
         return NULL;
     }
@@ -42,8 +42,8 @@ void log_process(process_t* process) {
  * @param process
  */
 void free_process(process_t* process) {
-    if (!process) {
-        free(process);
+    if (process) {
+        pool_free(process, sizeof(*process));
     }
 }
 
@@ -52,5 +52,5 @@ void free_process(process_t* process) {
  * @param process
  */
 void dlist_free_process(void* process) {
-    free(process);
+    free_process((process_t*)process);
 }
@@ -7,6 +7,7 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include "stdbool.h"
+#include "pool.h"
 
 typedef struct process {
     long long int timeArrived;
@@ -0,0 +1,107 @@
+/**
+ * Recency heap module
+ * Ties on last access are broken by position in the memory list, so the least recently used
+ * fragment is the same one a scan from the head of the list would pick.
+ */
+
+#include "recency_heap.h"
+
+#define RECENCY_HEAP_INITIAL_CAPACITY 16
+
+static memory_fragment_t* fragment_of(Node* node) {
+    return (memory_fragment_t*)node->data;
+}
+
+/**
+ * Returns if a node comes before another in the memory list.
+ * Fragments are in address order, and only empty fragments can share a start address,
+ * so only the run of fragments sharing the start address needs to be walked.
+ * @param a
+ * @param b
+ * @return
+ */
+static bool list_before(Node* a, Node* b) {
+    long long int byte_start = fragment_of(a)->byte_start;
+    if (byte_start != fragment_of(b)->byte_start) {
+        return byte_start < fragment_of(b)->byte_start;
+    }
+    for (Node* current = a->next; current && fragment_of(current)->byte_start == byte_start; current = current->next) {
+        if (current == b) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Orders fragments so the one to evict first is the smallest
+ * @param a
+ * @param b
+ * @return
+ */
+static int compare_recency(void* a, void* b) {
+    memory_fragment_t* fragment_a = a;
+    memory_fragment_t* fragment_b = b;
+    if (fragment_a->last_access != fragment_b->last_access) {
+        return fragment_a->last_access < fragment_b->last_access ? -1 : 1;
+    }
+    if (fragment_a == fragment_b) {
+        return 0;
+    }
+    return list_before(&fragment_a->node, &fragment_b->node) ? -1 : 1;
+}
+
+/**
+ * Create an empty recency heap
+ * @return
+ */
+recency_heap_t* create_recency_heap() {
+    return create_d_ary_heap(RECENCY_HEAP_INITIAL_CAPACITY, 2, compare_recency, offsetof(memory_fragment_t, recency_index));
+}
+
+/**
+ * Free a recency heap. The fragments are owned by the memory list.
+ * @param heap
+ */
+void free_recency_heap(recency_heap_t* heap) {
+    assert(heap);
+    free_heap(heap);
+}
+
+/**
+ * Add a process fragment to the heap
+ * @param heap
+ * @param node
+ */
+void recency_heap_insert(recency_heap_t* heap, Node* node) {
+    assert(fragment_of(node)->type == PROCESS_FRAGMENT);
+    heap_insert(heap, fragment_of(node));
+}
+
+/**
+ * Remove a process fragment from the heap
+ * @param heap
+ * @param node
+ */
+void recency_heap_remove(recency_heap_t* heap, Node* node) {
+    heap_remove(heap, fragment_of(node));
+}
+
+/**
+ * Restore the heap order after the last access time of a fragment has changed
+ * @param heap
+ * @param node
+ */
+void recency_heap_update(recency_heap_t* heap, Node* node) {
+    heap_update_key(heap, fragment_of(node));
+}
+
+/**
+ * Returns the least recently used process fragment
+ * @param heap
+ * @return NULL if the heap is empty
+ */
+Node* recency_heap_min(recency_heap_t* heap) {
+    memory_fragment_t* fragment = heap_peek_min(heap);
+    return fragment ? &fragment->node : NULL;
+}
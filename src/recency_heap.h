@@ -0,0 +1,27 @@
+/**
+ * Recency heap module.
+ * A binary min heap of process fragments keyed on last access time, used by swapping to find the
+ * least recently used process in O(1) and to update it in O(log n). Built on the generic heap.
+ */
+
+#ifndef SCHEDULER_RECENCY_HEAP_H
+#define SCHEDULER_RECENCY_HEAP_H
+
+#include <stdlib.h>
+#include <assert.h>
+#include <stdbool.h>
+#include "dlist.h"
+#include "heap.h"
+#include "memory_fragment.h"
+
+/* process fragments, each fragment stores its position in recency_index */
+typedef heap_t recency_heap_t;
+
+recency_heap_t* create_recency_heap();
+void free_recency_heap(recency_heap_t* heap);
+void recency_heap_insert(recency_heap_t* heap, Node* node);
+void recency_heap_remove(recency_heap_t* heap, Node* node);
+void recency_heap_update(recency_heap_t* heap, Node* node);
+Node* recency_heap_min(recency_heap_t* heap);
+
+#endif //SCHEDULER_RECENCY_HEAP_H
@@ -21,47 +21,16 @@ void inspectArguments(char* fileName, long long int schedulingAlgorithm, long lo
 }
 
 /**
- * Read process from text and load them to a dequeue
- * @param fileName
- * @param deque
- * @return
- */
-long long int readProcessesFromFile(char* fileName, Deque* deque) {
-    FILE *fp;
-    long long int count = 0;
-
-    fp = fopen(fileName, "r"); // read mode
-
-    if (fp == NULL){
-        perror("Error while opening the file.\n");
-        exit(EXIT_FAILURE);
-    }
-
-    long long int time = -1;
-    long long int pid =-1;
-    long long int memory = -1;
-    long long int jobTime = -1;
-
-    while((fscanf(fp, "%lld %lld %lld %lld\n", &time, &pid, &memory, &jobTime)) != EOF){
-        process_t* process = create_process(time, pid, memory, jobTime);
-        deque_push(deque, process);
-        count++;
-    }
-
-    fclose(fp);
-    return count;
-}
-
-/**
- * Simulates the execution of a process.
+ * Simulates the execution of a process for a number of ticks.
  * @param process
  * @param clock
+ * @param ticks
  */
-void execute(process_t* process, long long int clock) {
+void execute(process_t* process, long long int clock, long long int ticks) {
     static process_t* last = NULL;
-    process->remaining_time--;
+    process->remaining_time -= ticks;
     if (process!=last) {
-        fprintf(stderr, "<Scheduler> process %lld start executing, ETA: %lld ticks\n", process->pid, process->remaining_time);
+        fprintf(stderr, "<Scheduler> process %lld start executing, ETA: %lld ticks\n", process->pid, process->remaining_time + ticks - 1);
         last = process;
     }
     fprintf(stderr, "<Scheduler> process %lld is running, ETA: %lld ticks\n", process->pid, process->remaining_time);
@@ -74,24 +43,13 @@ void execute(process_t* process, long long int clock) {
  * @param clock
  * @return
  */
-long long int load_process(Deque* pending, Deque* suspended, long long int clock) {
-    long long int count = 0;
-    heap_t* toAdd = create_heap(MAX_PROCESS_ARRIVAL_PER_TICK, compare_PID);
-    while (deque_size(pending) && next_to_pop(pending)->timeArrived == clock) {
-        process_t* process = deque_pop(pending);
-        assert(process->timeArrived == clock);
-        heap_insert(toAdd, *process);
-        free_process(process);
-    }
-
-    while (heap_size(toAdd) > 0) {
-        process_t next_process = heap_pop_min(toAdd);
-        fprintf(stderr, "<Scheduler> Process %lld inserted to suspended queue\n", next_process.pid);
-        process_t* next = create_process(next_process.timeArrived, next_process.pid, next_process.memory, next_process.job_time);
-        deque_insert(suspended, next);
-        count++;
+long long int load_process(workload_t* pending, Deque* suspended, long long int clock) {
+    process_t** arrivals;
+    long long int count = workload_pop_arrivals(pending, clock, &arrivals);
+    for (long long int i=0; i<count; i++) {
+        fprintf(stderr, "<Scheduler> Process %lld inserted to suspended queue\n", arrivals[i]->pid);
+        deque_insert(suspended, arrivals[i]);
     }
-    free_heap(toAdd);
     return count;
 }
 
@@ -104,39 +62,82 @@ void tick(long long int* clock) {
 }
 
 /**
- * Initializer for FCFS and RR
- * @param processes
+ * Load all pending processes arrived no later than the given time.
+ * Processes arrived at the same time are still sorted by pid.
  * @param pending
  * @param suspended
+ * @param until
  * @return
  */
-long long int init(Deque *processes, Deque *pending, Deque *suspended) {
-    while (deque_size(processes) > 0) {
-        process_t *process = deque_pop(processes);
-        deque_push(pending, process);
+long long int load_process_until(workload_t* pending, Deque* suspended, long long int until) {
+    long long int count = 0;
+    while (workload_pending(pending) && workload_next(pending)->timeArrived <= until) {
+        count += load_process(pending, suspended, workload_next(pending)->timeArrived);
     }
-    return 0;
-};
+    return count;
+}
+
+/**
+ * Move the clock to the next arrival when there is no process ready to run.
+ * @param pending
+ * @param clock
+ */
+void idle(workload_t* pending, long long int* clock) {
+    if (workload_pending(pending) && workload_next(pending)->timeArrived > *clock) {
+        *clock = workload_next(pending)->timeArrived;
+    } else {
+        tick(clock);
+    }
+}
+
+/**
+ * Run a process for at most the given number of ticks, loading its pages first if required.
+ * Rather than ticking one by one, the clock jumps to the next event i.e. load completion,
+ * quantum expiry or job completion. Processes arriving in between are moved to suspended.
+ * @param allocator
+ * @param process
+ * @param pending
+ * @param suspended
+ * @param clock
+ * @param limit maximum number of ticks to execute
+ * @param lookahead 1 if arrivals at the end of a tick are loaded before the next tick, 0 otherwise
+ * @return number of ticks executed
+ */
+long long int run_process(memory_allocator_t* allocator, process_t* process, workload_t* pending, Deque* suspended,
+                          long long int* clock, long long int limit, long long int lookahead) {
+    if (limit <= 0 || process->remaining_time <= 0) {
+        return 0;
+    }
+    long long int loading = allocator->load_time_left(allocator->structure, process);
+    if (loading > 0) {
+        allocator->load_ticks(allocator->structure, process, loading);
+        load_process_until(pending, suspended, *clock + loading - 1 + lookahead);
+        *clock += loading;
+    }
+    long long int running = process->remaining_time < limit ? process->remaining_time : limit;
+    execute(process, *clock, running);
+    allocator->use_ticks(allocator->structure, process, *clock, running);
+    load_process_until(pending, suspended, *clock + running - 1 + lookahead);
+    *clock += running;
+    return running;
+}
 
 /**
  * First Come First Server Algorithm.
  * Processes are executed in order of their arrival time.
  * @param allocator
- * @param processes
- * @param finish
+ * @param pending
+ * @param statistics
  * @param clock
  */
-void firstComeFirstServe(memory_allocator_t* allocator, Deque* processes, Deque* finish, long long int* clock) {
+void firstComeFirstServe(memory_allocator_t* allocator, workload_t* pending, statistics_t* statistics, long long int* clock) {
     Deque *suspended = new_deque((void (*)(void *)) log_process);
-    Deque *pending = new_deque((void (*)(void *)) log_process);
 
-    init(processes, pending, suspended);
-
-    while (deque_size(suspended) > 0 || deque_size(pending) > 0) {
+    while (deque_size(suspended) > 0 || workload_pending(pending)) {
         load_process(pending, suspended, *clock);
         // continue if there is no process ready to run
         if (deque_size(suspended) == 0) {
-            tick(clock);
+            idle(pending, clock);
             continue;
         }
         process_t* process = deque_pop(suspended);
@@ -146,24 +147,13 @@ void firstComeFirstServe(memory_allocator_t* allocator, Deque* processes, Deque*
         }
         allocator->info(allocator->structure, process, *clock);
 
-        while (process->remaining_time > 0) {
-            if ((allocator->load_time_left(allocator->structure, process)) > 0) {
-                allocator->load(allocator->structure, process);
-            } else {
-                execute(process, *clock);
-                allocator->use(allocator->structure, process, *clock);
-
-            }
-            load_process(pending, suspended, *clock);
-            tick(clock);
-        }
+        run_process(allocator, process, pending, suspended, clock, process->remaining_time, 0);
         /* A process that has 0 seconds left to run, should be "evicted" from memory before marking the process as
          * finished
          */
         allocator->free(allocator->structure, process, *clock);
-        finish_process(process, finish, *clock, deque_size(suspended));
+        finish_process(process, statistics, *clock, deque_size(suspended));
     }
-    free_deque(pending);
     free_deque(suspended);
 }
 
@@ -172,24 +162,18 @@ void firstComeFirstServe(memory_allocator_t* allocator, Deque* processes, Deque*
  * Each process is given a fixed time to run(quantum),
  * if not finished, the process will be moved to the end of the queue.
  * @param allocator
- * @param processes
- * @param finish
+ * @param pending
+ * @param statistics
  * @param clock
  * @param quantum
  */
-void roundRobin(memory_allocator_t* allocator, Deque* processes, Deque* finish, long long int* clock, long long int quantum) {
+void roundRobin(memory_allocator_t* allocator, workload_t* pending, statistics_t* statistics, long long int* clock, long long int quantum) {
     Deque *suspended = new_deque((void (*)(void *)) log_process);
-    Deque *pending = new_deque((void (*)(void *)) log_process);
-    /*
-     * Sort process by pid and add to pending and suspended
-     */
-    init(processes, pending, suspended);
 
-    while (deque_size(pending) > 0 || deque_size(suspended) > 0) {
+    while (workload_pending(pending) || deque_size(suspended) > 0) {
         load_process(pending, suspended, *clock);
         // continue if there is no process ready to run
         if (deque_size(suspended) > 0) {
-            long long int quantumLeft = quantum;
             /* Pops the next process to run
              */
             process_t* process = deque_pop(suspended);
@@ -206,19 +190,7 @@ void roundRobin(memory_allocator_t* allocator, Deque* processes, Deque* finish,
             process->remaining_time += page_fault_time;
             allocator->info(allocator->structure, process, *clock);
 
-            while (quantumLeft > 0 && process->remaining_time > 0) {
-                // Allocate space for the process if it's not in the memory
-                if ((allocator->load_time_left(allocator->structure, process)) > 0) {
-                    allocator->load(allocator->structure, process);
-                }
-                else {
-                    execute(process, *clock);
-                    allocator->use(allocator->structure, process, *clock);
-                    quantumLeft--;
-                }
-                tick(clock);
-                load_process(pending, suspended, *clock);
-            }
+            run_process(allocator, process, pending, suspended, clock, quantum, 1);
             /*
              * If a process hasn't finished at the end of its quantum,
              * insert it back to the queue.
@@ -227,15 +199,14 @@ void roundRobin(memory_allocator_t* allocator, Deque* processes, Deque* finish,
                 deque_insert(suspended, process);
             } else {
                 allocator->free(allocator->structure, process, *clock);
-                finish_process(process, finish, *clock, deque_size(suspended));
+                finish_process(process, statistics, *clock, deque_size(suspended));
             }
         }
         else {
-            tick(clock);
+            idle(pending, clock);
         }
 
     }
-    free_deque(pending);
     free_deque(suspended);
 }
 /**
@@ -256,26 +227,6 @@ int compare_remaining_time(void * a, void * b) {
     }
 }
 
-/**
- * Comparator for heap to compare pid of two processes.
- * @param a
- * @param b
- * @return
- */
-int compare_PID(void * a, void * b) {
-    long long int pid1 = ((process_t *)a)->pid;
-    long long int pid2 = ((process_t *)b)->pid;
-    if (pid1 > pid2) {
-        return 1;
-    }
-    else if (pid2 > pid1) {
-        return -1;
-    }
-    else {
-        return 0;
-    }
-}
-
 
 /**
  * Shortest Remaining Time First Algorithm.
@@ -283,94 +234,166 @@ int compare_PID(void * a, void * b) {
  * The chosen process continue to execute until it completes or a new process is added
  * that requires a smaller amount of time. I
  * @param allocator
- * @param processes
- * @param finish
+ * @param pending
+ * @param statistics
  * @param clock
  */
-void shortestRemainingTimeFirst(memory_allocator_t* allocator, Deque* processes, Deque* finish, long long int* clock) {
-    heap_t *suspended = create_heap(deque_size(processes), compare_remaining_time);
-    Deque *pending = new_deque((void (*)(void *)) log_process);
+void shortestRemainingTimeFirst(memory_allocator_t* allocator, workload_t* pending, statistics_t* statistics, long long int* clock) {
+    heap_t *suspended = create_heap(INITIAL_SUSPENDED_CAPACITY, compare_remaining_time);
     /**
      * Keep track of the last process to avoid duplicate page fault penalty
      */
     long long int last_pid = -1;
-    while (deque_size(processes) > 0) {
-        process_t *process = deque_pop(processes);
-        deque_push(pending, process);
-    }
-
-    while (heap_size(suspended) > 0 || deque_size(pending) > 0){
-        load_new_process(suspended, pending, *clock);
-        /**
-         * Execute the process with the shortest remaining time.
-         */
-        if (heap_size(suspended) > 0) {
-            process_t* process = NULL;
-            process_t running = heap_pop_min(suspended);
-            process = &running;
+    /**
+     * The running process is kept out of the heap, only arrivals can preempt it
+     */
+    process_t* running = NULL;
 
+    while (running || heap_size(suspended) > 0 || workload_pending(pending)){
+        long long int arrived = load_new_process(suspended, pending, *clock);
+        if (running && arrived > 0 && compare_remaining_time(heap_peek_min(suspended), running) < 0) {
+            heap_insert(suspended, running);
+            running = NULL;
+        }
+        if (!running && heap_size(suspended) > 0) {
+            running = heap_pop_min(suspended);
             /**
              * Allocate memory for this process
              */
-            if (allocator->require_allocation(allocator->structure, process)){
-                allocator->malloc(allocator->structure, process, *clock);
+            if (allocator->require_allocation(allocator->structure, running)){
+                allocator->malloc(allocator->structure, running, *clock);
             }
             /**
              * Apply page fault penalty
              */
-            if (process->pid != last_pid) {
-                long long int page_fault_time = allocator->page_fault(allocator->structure, process) > 0;
-                process->remaining_time += page_fault_time;
-                allocator->info(allocator->structure, process, *clock);
-            }
-
-
-            if ((allocator->load_time_left(allocator->structure, process)) > 0) {
-                allocator->load(allocator->structure, process);
-            } else {
-                execute(process, *clock);
-                allocator->use(allocator->structure, process, *clock);
-            }
-            last_pid = process->pid;
-            tick(clock);
-            load_new_process(suspended, pending, *clock);
-
-            if (process->remaining_time == 0) {
-                allocator->free(allocator->structure, process, *clock);
-                process_t * copy = create_process(process->timeArrived, process->pid, process->memory, process->job_time);
-                copy->finish_time = *clock;
-                deque_insert(finish, copy);
-            } else {
-                heap_insert(suspended, running);
+            if (running->pid != last_pid) {
+                long long int page_fault_time = allocator->page_fault(allocator->structure, running) > 0;
+                running->remaining_time += page_fault_time;
+                allocator->info(allocator->structure, running, *clock);
             }
+            last_pid = running->pid;
+        }
+        if (!running) {
+            idle(pending, clock);
+            continue;
+        }
 
+        /**
+         * Nothing can preempt the process before the next arrival, so it loads and executes until then in one step
+         */
+        long long int slice = workload_pending(pending) ? workload_next(pending)->timeArrived - *clock : LLONG_MAX;
+        long long int loading = allocator->load_time_left(allocator->structure, running);
+        if (loading > 0) {
+            loading = loading < slice ? loading : slice;
+            allocator->load_ticks(allocator->structure, running, loading);
+            *clock += loading;
+            slice -= loading;
+        }
+        if (slice > 0 && allocator->load_time_left(allocator->structure, running) == 0) {
+            long long int ticks = running->remaining_time < slice ? running->remaining_time : slice;
+            execute(running, *clock, ticks);
+            allocator->use_ticks(allocator->structure, running, *clock, ticks);
+            *clock += ticks;
+        }
 
-        } else {
-            tick(clock);
+        if (running->remaining_time == 0) {
+            allocator->free(allocator->structure, running, *clock);
+            running->finish_time = *clock;
+            record_finish(statistics, running);
+            free_process(running);
+            running = NULL;
         }
     }
+    free_heap(suspended);
 }
 /**
  * Load new process for the shorest remaining first algorithm.
  * @param suspended
  * @param pending
  * @param clock
+ * @return number of processes loaded
  */
-void load_new_process(heap_t* suspended, Deque* pending, long long int clock) {
+long long int load_new_process(heap_t* suspended, workload_t* pending, long long int clock) {
     // Add newly arrived processes
-    heap_t* toAdd = create_heap(MAX_PROCESS_ARRIVAL_PER_TICK, compare_PID);
-    while (deque_size(pending) && next_to_pop(pending)->timeArrived == clock) {
-        process_t* process = deque_pop(pending);
-        assert(process->timeArrived == clock);
-        heap_insert(toAdd, *process);
-        free_process(process);
-        fprintf(stderr, "Process %lld added to suspended\n", process->pid);
-        log_process(process);
+    process_t** arrivals;
+    long long int count = workload_pop_arrivals(pending, clock, &arrivals);
+    for (long long int i=0; i<count; i++) {
+        fprintf(stderr, "Process %lld added to suspended\n", arrivals[i]->pid);
+        log_process(arrivals[i]);
+        heap_insert(suspended, arrivals[i]);
+    }
+    return count;
+}
+
+/**
+ * Simulate a workload from start to end
+ * @param allocator
+ * @param file_name
+ * @param scheduling_algorithm
+ * @param quantum
+ * @param statistics statistics of finished processes
+ * @return the makespan
+ */
+long long int simulate(memory_allocator_t* allocator, char* file_name, long long int scheduling_algorithm,
+                       long long int quantum, statistics_t* statistics) {
+    /*
+     * Processes are read from the workload as they arrive
+     */
+    workload_t *workload = open_workload(file_name);
+    long long int clock = 0;
+
+    if (scheduling_algorithm == FIRST_COME_FIRST_SERVED) {
+        firstComeFirstServe(allocator, workload, statistics, &clock) ;
+    } else if (scheduling_algorithm == ROUND_ROBIN) {
+        roundRobin(allocator, workload, statistics, &clock, quantum);
+    } else if (scheduling_algorithm == CUSTOMISED_SCHEDULING) {
+        shortestRemainingTimeFirst(allocator, workload, statistics, &clock);
     }
-    while (heap_size(toAdd) > 0) {
-        process_t next = heap_pop_min(toAdd);
-        heap_insert(suspended, next);
+    close_workload(workload);
+    return clock;
+}
+
+/**
+ * Record the runs of every process for OPT, by simulating the workload once with output discarded.
+ * OPT knows nothing of the future while recording, so the recording pass evicts as LRU does.
+ * @param file_name
+ * @param scheduling_algorithm
+ * @param memory_size
+ * @param quantum
+ * @return the schedule, ready to be replayed
+ */
+next_use_t* record_schedule(char* file_name, long long int scheduling_algorithm, long long int memory_size, long long int quantum) {
+    next_use_t* schedule = create_next_use();
+    memory_allocator_t* allocator = create_virtual_memory_allocator_OPT(memory_size, PAGE_SIZE, schedule);
+    statistics_t* statistics = create_statistics();
+
+    fflush(stdout);
+    fflush(stderr);
+    int saved_stdout = dup(STDOUT_FILENO);
+    int saved_stderr = dup(STDERR_FILENO);
+    int discard = open("/dev/null", O_WRONLY);
+    if (saved_stdout < 0 || saved_stderr < 0 || discard < 0) {
+        perror("record_schedule");
+        exit(EXIT_FAILURE);
     }
+    dup2(discard, STDOUT_FILENO);
+    dup2(discard, STDERR_FILENO);
+    close(discard);
+
+    simulate(allocator, file_name, scheduling_algorithm, quantum, statistics);
+
+    fflush(stdout);
+    fflush(stderr);
+    dup2(saved_stdout, STDOUT_FILENO);
+    dup2(saved_stderr, STDERR_FILENO);
+    close(saved_stdout);
+    close(saved_stderr);
+
+    free_statistics(statistics);
+    free_memory((virtual_memory_t*) allocator->structure);
+    free(allocator);
+    next_use_replay(schedule);
+    return schedule;
 }
 
 int main(int argc, char *argv[]) {
@@ -379,12 +402,13 @@ int main(int argc, char *argv[]) {
     long long int memory_allocation = -1;
     long long int memory_size = -1;
     long long int quantum = 10;
+    char* output_name = NULL;
 
     /**
      * Read configurations from arguments
      */
     char opt;
-    while ((opt = getopt (argc, argv, ":f:a:m:s:q:")) != -1) {
+    while ((opt = getopt (argc, argv, ":f:a:m:s:q:o:")) != -1) {
         switch (opt) {
             case 'f':
                 file_name = malloc(sizeof(file_name) * (strlen(optarg)+1));
@@ -409,6 +433,18 @@ int main(int argc, char *argv[]) {
                     memory_allocation = VIRTUAL_MEMORY;
                 } else if (strcasecmp(optarg, "cm") == 0) {
                     memory_allocation = CUSTOMISED_MEMORY;
+                } else if (strcasecmp(optarg, "clock") == 0) {
+                    memory_allocation = CLOCK_MEMORY;
+                } else if (strcasecmp(optarg, "wsclock") == 0) {
+                    memory_allocation = WSCLOCK_MEMORY;
+                } else if (strcasecmp(optarg, "arc") == 0) {
+                    memory_allocation = ARC_MEMORY;
+                } else if (strcasecmp(optarg, "opt") == 0) {
+                    memory_allocation = OPTIMAL_MEMORY;
+                } else if (strcasecmp(optarg, "mglru") == 0) {
+                    memory_allocation = MGLRU_MEMORY;
+                } else if (strcasecmp(optarg, "lru") == 0) {
+                    memory_allocation = PAGE_LRU_MEMORY;
                 }
                 break;
             case 's':
@@ -417,54 +453,78 @@ int main(int argc, char *argv[]) {
             case 'q':
                 quantum = atoll(optarg);
                 break;
+            case 'o':
+                output_name = optarg;
+                break;
             default:
                 abort();
         }
     }
 
+    /*
+     * Convert the workload to a binary trace instead of simulating it
+     */
+    if (output_name) {
+        if (file_name == NULL) {
+            fprintf(stderr, "usage: %s -f <workload> -o <binary trace>\n", argv[0]);
+            return 1;
+        }
+        long long int count = convert_trace(file_name, output_name);
+        free(file_name);
+        if (count < 0) {
+            return 1;
+        }
+        fprintf(stderr, "<Trace> %lld processes written to %s\n", count, output_name);
+        return 0;
+    }
+
 //    inspectArguments(file_name, scheduling_algorithm, memory_allocation, memory_size, quantum);
 
     /*
      * Create a memory allocator based on input argument
      */
     memory_allocator_t* allocator = NULL;
+    next_use_t* schedule = NULL;
     if (memory_allocation == UNLIMITED) {
         allocator = create_unlimited_allocator();
     } else if (memory_allocation == SWAPPING) {
         allocator = create_swapping_allocator(memory_size, PAGE_SIZE);
     } else if (memory_allocation == VIRTUAL_MEMORY) {
         allocator = create_virtual_memory_allocator_LRU(memory_size, PAGE_SIZE);
+    } else if (memory_allocation == CLOCK_MEMORY) {
+        allocator = create_virtual_memory_allocator_CLOCK(memory_size, PAGE_SIZE);
+    } else if (memory_allocation == WSCLOCK_MEMORY) {
+        allocator = create_virtual_memory_allocator_WSCLOCK(memory_size, PAGE_SIZE);
+    } else if (memory_allocation == ARC_MEMORY) {
+        allocator = create_virtual_memory_allocator_ARC(memory_size, PAGE_SIZE);
+    } else if (memory_allocation == OPTIMAL_MEMORY) {
+        schedule = record_schedule(file_name, scheduling_algorithm, memory_size, quantum);
+        allocator = create_virtual_memory_allocator_OPT(memory_size, PAGE_SIZE, schedule);
+    } else if (memory_allocation == MGLRU_MEMORY) {
+        allocator = create_virtual_memory_allocator_MGLRU(memory_size, PAGE_SIZE);
+    } else if (memory_allocation == PAGE_LRU_MEMORY) {
+        allocator = create_virtual_memory_allocator_page_LRU(memory_size, PAGE_SIZE);
     } else {
         allocator = create_virtual_memory_allocator_LFU(memory_size, PAGE_SIZE);
     }
 
     /*
-     * Dequeue to store all processes
-     */
-    Deque *processes = new_deque((void (*)(void *)) log_process);
-    /*
-     * Dequeue to store finished processes for statistic
+     * Statistic of finished processes
      */
-    Deque *finish = new_deque((void (*)(void *)) log_process);
-    readProcessesFromFile(file_name, processes);
-    long long int clock = 0;
+    statistics_t *statistics = create_statistics();
 
     /**
-     * Creates a memory allocator based on selected algorithm
+     * Simulate the workload with the selected algorithm
      */
-    if (scheduling_algorithm == FIRST_COME_FIRST_SERVED) {
-        firstComeFirstServe(allocator, processes, finish, &clock) ;
-    } else if (scheduling_algorithm == ROUND_ROBIN) {
-        roundRobin(allocator, processes, finish, &clock, quantum);
-    } else if (scheduling_algorithm == CUSTOMISED_SCHEDULING) {
-        shortestRemainingTimeFirst(allocator, processes, finish, &clock);
-    }
+    long long int clock = simulate(allocator, file_name, scheduling_algorithm, quantum, statistics);
     /**
      * Analysis statistic of finished processes
      */
-    analysis(finish, clock);
-    free_deque(processes);
-    free_deque(finish);
+    analysis(statistics, clock);
+    if (memory_allocation == ARC_MEMORY) {
+        print_arc_index(((virtual_memory_t*) allocator->structure)->arc);
+    }
+    free_statistics(statistics);
     free(file_name);
 
     /**
@@ -478,6 +538,11 @@ int main(int argc, char *argv[]) {
         free_memory(((virtual_memory_t *) allocator->structure));
     }
     free(allocator);
+    if (schedule) {
+        free_next_use(schedule);
+    }
+    /* Release the pools of records at once */
+    pool_release_all();
 
     return 0;
 }
@@ -504,8 +569,15 @@ int cmp_long_long_int (const void * a, const void * b) {
  * Print address in the specific format
  */
 void print_memory(long long int* addresses, long long int count) {
-    printf("[");
     qsort(addresses, count, sizeof(*addresses), cmp_long_long_int);
+    print_sorted_memory(addresses, count);
+}
+
+/*
+ * Print address already in increasing order in the specific format
+ */
+void print_sorted_memory(long long int* addresses, long long int count) {
+    printf("[");
     for (long long int i=0; i<count; i++) {
         if (i == 0) {
             printf("%lld", addresses[i]);
@@ -518,65 +590,12 @@ void print_memory(long long int* addresses, long long int count) {
 }
 
 /*
- * Move a process to finished
+ * Record statistic of a finished process then free it
  */
-void finish_process(process_t* process, Deque* finish, long long int clock, long long int proc_remaining) {
+void finish_process(process_t* process, statistics_t* statistics, long long int clock, long long int proc_remaining) {
     fprintf(stderr, "<Scheduler> Process %lld finished\n",process->pid);
     process->finish_time = clock;
     output_finish(clock, process, proc_remaining);
-    deque_insert(finish, process);
+    record_finish(statistics, process);
+    free_process(process);
 }
-/*
- * Analysis the statistic of finished processes
- */
-void analysis(Deque* finished, long long int clock) {
-    long long int interval = (int)ceil((double)(clock)/61);
-    long long int throughput[interval];
-    for (long long int i=0; i<interval; i++) {
-        throughput[i] = 0;
-    }
-
-    long long int total_job = deque_size(finished);
-    long long int total_turn_around = 0;
-    long long int total_job_time = 0;
-    double max_overhead = 0;
-    double total_overhead = 0;
-    while (deque_size(finished) > 0) {
-        process_t* process = deque_pop(finished);
-        long long int turn_around = process->finish_time - process->timeArrived;
-        double overhead = (double)turn_around/(double)process->job_time;
-        total_overhead += overhead;
-        if (overhead > max_overhead) {
-            max_overhead = overhead;
-        }
-        for (long long int t=0; t<interval;t++) {
-            if (process->finish_time > 60*t && process->finish_time<= 60*(t+1)) {
-                throughput[t] += 1;
-                break;
-            }
-        }
-        total_turn_around += turn_around;
-        total_job_time += process->job_time;
-        free_process(process);
-    }
-
-    long long int throughput_total = 0;
-    long long int throughput_min = INT_MAX;
-    long long int throughput_max = INT_MIN;
-
-    for (long long int j=0; j<interval; j++) {
-        throughput_total += throughput[j];
-        if (throughput[j] < throughput_min) {
-            throughput_min = throughput[j];
-        }
-        if (throughput[j] > throughput_max) {
-            throughput_max = throughput[j];
-        }
-
-    }
-
-    printf("Throughput %d, %lld, %lld\n", (int)ceil((double)throughput_total/(double)interval), throughput_min, throughput_max);
-    printf("Turnaround time %d\n", (int)ceil((double)total_turn_around/(double)total_job));
-    printf("Time overhead %.2f %.2f\n", max_overhead, (double)total_overhead/(double)total_job);
-    printf("Makespan %lld\n", clock);
-}
\ No newline at end of file
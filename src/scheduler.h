@@ -11,6 +11,7 @@
 #include <assert.h>
 #include <ctype.h>
 #include <unistd.h>
+#include <fcntl.h>
 
 #include "process.h"
 #include "heap.h"
@@ -20,15 +21,31 @@
 #include "unlimited.h"
 #include "deque.h"
 #include "virtual_memory.h"
+#include "trace.h"
+#include "workload.h"
+#include "statistics.h"
+#include "next_use.h"
 
-int compare_PID(void * a, void * b);
 
-void firstComeFirstServe(memory_allocator_t* allocator, Deque* processes, Deque* finish, long long int* clock);
-void execute(process_t* process, long long int clock);
-void finish_process(process_t* process, Deque* finish, long long int clock, long long int proc_remaining);
-void analysis(Deque* finished, long long int clock);
-void load_new_process(heap_t* suspended, Deque* pending, long long int clock);
+
+void firstComeFirstServe(memory_allocator_t* allocator, workload_t* pending, statistics_t* statistics, long long int* clock);
+void roundRobin(memory_allocator_t* allocator, workload_t* pending, statistics_t* statistics, long long int* clock, long long int quantum);
+void shortestRemainingTimeFirst(memory_allocator_t* allocator, workload_t* pending, statistics_t* statistics, long long int* clock);
+void execute(process_t* process, long long int clock, long long int ticks);
+void tick(long long int* clock);
+void idle(workload_t* pending, long long int* clock);
+long long int load_process(workload_t* pending, Deque* suspended, long long int clock);
+long long int load_process_until(workload_t* pending, Deque* suspended, long long int until);
+long long int run_process(memory_allocator_t* allocator, process_t* process, workload_t* pending, Deque* suspended,
+                          long long int* clock, long long int limit, long long int lookahead);
+void finish_process(process_t* process, statistics_t* statistics, long long int clock, long long int proc_remaining);
+long long int load_new_process(heap_t* suspended, workload_t* pending, long long int clock);
 void print_memory(long long int* addresses, long long int count);
+void print_sorted_memory(long long int* addresses, long long int count);
+long long int simulate(memory_allocator_t* allocator, char* file_name, long long int scheduling_algorithm,
+                       long long int quantum, statistics_t* statistics);
+next_use_t* record_schedule(char* file_name, long long int scheduling_algorithm, long long int memory_size, long long int quantum);
 
-#define MAX_PROCESS_ARRIVAL_PER_TICK 100
+/* Initial capacity of the SRTF suspended heap, which grows as needed */
+#define INITIAL_SUSPENDED_CAPACITY 100
 #endif //COMP30023_2020_PROJECT_2_SCHEDULER_H
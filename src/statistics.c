@@ -0,0 +1,160 @@
+/**
+ * Statistics module
+ * Throughput is counted per interval of 60 ticks, reported over ceil(makespan/61) intervals.
+ */
+
+#include <string.h>
+#include "statistics.h"
+
+/**
+ * Returns the number of intervals reported for a given makespan
+ * @param clock
+ * @return
+ */
+static long long int interval_count(long long int clock) {
+    return (int)ceil((double)(clock)/61);
+}
+
+/**
+ * Create an empty set of statistics
+ * @return
+ */
+statistics_t* create_statistics() {
+    statistics_t* statistics = malloc(sizeof(*statistics));
+    assert(statistics);
+    statistics->total_job = 0;
+    statistics->total_turn_around = 0;
+    statistics->total_job_time = 0;
+    statistics->max_overhead = 0;
+    statistics->total_overhead = 0;
+    statistics->throughput_total = 0;
+    statistics->throughput_min = INT_MAX;
+    statistics->throughput_max = INT_MIN;
+    statistics->occupied = 0;
+    statistics->run_head = 0;
+    statistics->run_size = 0;
+    statistics->run_capacity = 16;
+    statistics->run_interval = malloc(sizeof(*statistics->run_interval) * statistics->run_capacity);
+    statistics->run_count = malloc(sizeof(*statistics->run_count) * statistics->run_capacity);
+    assert(statistics->run_interval && statistics->run_count);
+    return statistics;
+}
+
+/**
+ * Free statistics
+ * @param statistics
+ */
+void free_statistics(statistics_t* statistics) {
+    assert(statistics);
+    free(statistics->run_interval);
+    free(statistics->run_count);
+    free(statistics);
+}
+
+/**
+ * Append a new run at the end of the run queue
+ * @param statistics
+ * @param interval
+ */
+static void push_run(statistics_t* statistics, long long int interval) {
+    if (statistics->run_head + statistics->run_size == statistics->run_capacity) {
+        if (statistics->run_head > 0) {
+            /* Reuse the space of folded runs */
+            memmove(statistics->run_interval, statistics->run_interval + statistics->run_head,
+                    sizeof(*statistics->run_interval) * statistics->run_size);
+            memmove(statistics->run_count, statistics->run_count + statistics->run_head,
+                    sizeof(*statistics->run_count) * statistics->run_size);
+            statistics->run_head = 0;
+        } else {
+            statistics->run_capacity *= 2;
+            statistics->run_interval = realloc(statistics->run_interval, sizeof(*statistics->run_interval) * statistics->run_capacity);
+            statistics->run_count = realloc(statistics->run_count, sizeof(*statistics->run_count) * statistics->run_capacity);
+            assert(statistics->run_interval && statistics->run_count);
+        }
+    }
+    long long int tail = statistics->run_head + statistics->run_size;
+    statistics->run_interval[tail] = interval;
+    statistics->run_count[tail] = 1;
+    statistics->run_size++;
+}
+
+/**
+ * Move the oldest run into the throughput of intervals within the makespan
+ * @param statistics
+ */
+static void fold_run(statistics_t* statistics) {
+    long long int count = statistics->run_count[statistics->run_head];
+    statistics->throughput_total += count;
+    statistics->occupied++;
+    if (count < statistics->throughput_min) {
+        statistics->throughput_min = count;
+    }
+    if (count > statistics->throughput_max) {
+        statistics->throughput_max = count;
+    }
+    statistics->run_head++;
+    statistics->run_size--;
+}
+
+/**
+ * Record a finished process. The process must finish no earlier than processes recorded before it.
+ * @param statistics
+ * @param process
+ */
+void record_finish(statistics_t* statistics, process_t* process) {
+    long long int turn_around = process->finish_time - process->timeArrived;
+    double overhead = (double)turn_around/(double)process->job_time;
+    statistics->total_overhead += overhead;
+    if (overhead > statistics->max_overhead) {
+        statistics->max_overhead = overhead;
+    }
+    statistics->total_turn_around += turn_around;
+    statistics->total_job_time += process->job_time;
+    statistics->total_job++;
+
+    if (process->finish_time <= 0) {
+        return;
+    }
+    /* A process finished at (60*t, 60*(t+1)] belongs to interval t */
+    long long int interval = (process->finish_time - 1) / 60;
+    long long int tail = statistics->run_head + statistics->run_size - 1;
+    if (statistics->run_size > 0 && statistics->run_interval[tail] == interval) {
+        statistics->run_count[tail]++;
+    } else {
+        push_run(statistics, interval);
+    }
+    /* The makespan is at least this finish time, so earlier complete runs are known to be within it */
+    long long int reported = interval_count(process->finish_time);
+    while (statistics->run_size > 1 && statistics->run_interval[statistics->run_head] < reported) {
+        fold_run(statistics);
+    }
+}
+
+/*
+ * Analysis the statistic of finished processes
+ */
+void analysis(statistics_t* statistics, long long int clock) {
+    long long int interval = interval_count(clock);
+    while (statistics->run_size > 0 && statistics->run_interval[statistics->run_head] < interval) {
+        fold_run(statistics);
+    }
+
+    long long int total_job = statistics->total_job;
+    long long int throughput_total = statistics->throughput_total;
+    long long int throughput_min = statistics->throughput_min;
+    long long int throughput_max = statistics->throughput_max;
+    /* Intervals without any process finished */
+    if (statistics->occupied < interval) {
+        if (throughput_min > 0) {
+            throughput_min = 0;
+        }
+        if (throughput_max < 0) {
+            throughput_max = 0;
+        }
+    }
+
+    printf("Throughput %d, %lld, %lld\n", (int)ceil((double)throughput_total/(double)interval), throughput_min, throughput_max);
+    printf("Turnaround time %d\n", (int)ceil((double)statistics->total_turn_around/(double)total_job));
+    printf("Time overhead %.2f %.2f\n", statistics->max_overhead, (double)statistics->total_overhead/(double)total_job);
+    printf("Makespan %lld\n", clock);
+}
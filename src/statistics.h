@@ -0,0 +1,41 @@
+/**
+ * Statistics module.
+ * Accumulates statistics of finished processes as they finish, so that they don't need to be kept until the end.
+ */
+
+#ifndef SCHEDULER_STATISTICS_H
+#define SCHEDULER_STATISTICS_H
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <assert.h>
+#include <limits.h>
+#include <math.h>
+#include "process.h"
+
+typedef struct statistics {
+    long long int total_job;
+    long long int total_turn_around;
+    long long int total_job_time;
+    double max_overhead;
+    double total_overhead;
+    /* Throughput of intervals known to be within the makespan */
+    long long int throughput_total;
+    long long int throughput_min;
+    long long int throughput_max;
+    long long int occupied;
+    /* Intervals that may still lie beyond the makespan, kept as (interval, count) runs.
+     * Processes finish in order, so runs are sorted by interval. */
+    long long int* run_interval;
+    long long int* run_count;
+    long long int run_head;
+    long long int run_size;
+    long long int run_capacity;
+} statistics_t;
+
+statistics_t* create_statistics();
+void free_statistics(statistics_t* statistics);
+void record_finish(statistics_t* statistics, process_t* process);
+void analysis(statistics_t* statistics, long long int clock);
+
+#endif //SCHEDULER_STATISTICS_H
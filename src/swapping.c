@@ -16,11 +16,16 @@ memory_list_t* create_memory_list(long long int mem_size, long long int page_siz
     memory_list_t* m_list = (memory_list_t*)malloc(sizeof(*m_list));
     assert(m_list);
     m_list->page_size = page_size;
-    m_list->list = new_dlist(dlist_free_fragment, (void (*)(void *)) print_fragment);
+    m_list->list = new_intrusive_dlist(dlist_free_fragment, (void (*)(void *)) print_fragment);
     assert(m_list->list);
     /* The first process is always given a memory page 0*/
     memory_fragment_t* empty_memory = create_hole_fragment(0, 0, mem_size, byteToAvailablePage(mem_size, page_size));
-    dlist_add_start(m_list->list, empty_memory);
+    m_list->holes = create_hole_index();
+    m_list->fragments = create_pid_map();
+    m_list->recency = create_recency_heap();
+    m_list->total_pages = empty_memory->page_length;
+    m_list->pages_in_use = 0;
+    hole_index_insert(m_list->holes, dlist_link_start(m_list->list, &empty_memory->node, empty_memory));
     return m_list;
 }
 
@@ -31,14 +36,17 @@ memory_list_t* create_memory_list(long long int mem_size, long long int page_siz
 void free_memory_list(memory_list_t* memoryList) {
     assert(memoryList);
     free_dlist(memoryList->list);
+    free_hole_index(memoryList->holes);
+    free_pid_map(memoryList->fragments);
+    free_recency_heap(memoryList->recency);
     free(memoryList);
 }
 
 /**
- * Find the first memory fragment that has enough space for the given process
+ * Find the first memory fragment that has enough space for the given process.
+ * Holes are looked up through the hole index rather than walking the list.
  * @param memoryList
  * @param process
- * @param clock current time for logging purpose
  * @return
  */
 Node* first_fit(memory_list_t* memoryList, process_t* process) {
@@ -48,16 +56,12 @@ Node* first_fit(memory_list_t* memoryList, process_t* process) {
      * Find how many pages are required. If a process need 98 bytes, 25 pages are required.
      */
     long long int pages_required = byteToRequiredPage(process->memory, memoryList->page_size);
-    Node* current = memoryList->list->head;
-    while (current) {
-        memory_fragment_t* fragment = (memory_fragment_t*) current->data;
-        if (fragment->type == HOLE_FRAGMENT && fragment->page_length >= pages_required) {
-            fprintf(stderr, "<MEMORY> First fit for pid %lld (%lld pages) is at %lld\n", process->pid, pages_required, fragment->page_start);
-            return current;
-        }
-        current = current->next;
+    Node* fit = hole_index_first_fit(memoryList->holes, pages_required);
+    if (fit) {
+        memory_fragment_t* fragment = (memory_fragment_t*) fit->data;
+        fprintf(stderr, "<MEMORY> First fit for pid %lld (%lld pages) is at %lld\n", process->pid, pages_required, fragment->page_start);
     }
-    return NULL;
+    return fit;
 }
 
 /**
@@ -96,14 +100,18 @@ Node* allocate(memory_list_t* memoryList, Node* hole, process_t* process) {
     long long int required_page = byteToRequiredPage(process->memory, memoryList->page_size);
     // Calculate how much space will be required to save these pages.
     long long int required_memory = required_page*4;
+    // The hole is about to be occupied
+    hole_index_remove(memoryList->holes, hole);
     // Break the hole into two parts
-    dlist_insert_after(memoryList->list, hole,
-            create_hole_fragment(
-                    fragment->byte_start + required_memory,
-                    fragment->page_start + required_page,
-                    fragment->byte_length - required_memory,
-                    byteToAvailablePage(fragment->byte_length - required_memory, memoryList->page_size)
-                    ));
+    memory_fragment_t* rest = create_hole_fragment(
+            fragment->byte_start + required_memory,
+            fragment->page_start + required_page,
+            fragment->byte_length - required_memory,
+            byteToAvailablePage(fragment->byte_length - required_memory, memoryList->page_size)
+            );
+    hole_index_insert(memoryList->holes, dlist_link_after(memoryList->list, hole, &rest->node, rest));
+    memoryList->total_pages += required_page + rest->page_length - fragment->page_length;
+    memoryList->pages_in_use += required_page;
     // Convert the hole fragment to a process fragment
     fragment->byte_length = required_memory;
     // update page start
@@ -111,6 +119,8 @@ Node* allocate(memory_list_t* memoryList, Node* hole, process_t* process) {
     fragment->load_time = LOADING_TIME_PER_PAGE * required_page;
     fragment->type = PROCESS_FRAGMENT;
     fragment->pid = process->pid;
+    pid_map_put(memoryList->fragments, process->pid, hole);
+    recency_heap_insert(memoryList->recency, hole);
     fprintf(stderr, "<Scheduler> Memory allocated for process %lld (%lld bytes)\n", process->pid, process->memory);
     return hole;
 }
@@ -122,16 +132,9 @@ Node* allocate(memory_list_t* memoryList, Node* hole, process_t* process) {
  * @return
  */
 long long int swapping_load_time_left(memory_list_t* memoryList, process_t* process) {
-    Node* current = memoryList->list->head;
-    memory_fragment_t* fragment = NULL;
-    while (current) {
-        fragment = (memory_fragment_t*)current->data;
-        if (fragment->type == PROCESS_FRAGMENT) {
-            if (fragment->pid == process->pid) {
-                return fragment->load_time ;
-            }
-        }
-        current = current->next;
+    memory_fragment_t* fragment = get_fragment(memoryList, process);
+    if (fragment) {
+        return fragment->load_time;
     }
     return -1;
 }
@@ -143,17 +146,24 @@ long long int swapping_load_time_left(memory_list_t* memoryList, process_t* proc
  * @param process
  */
 void swapping_load_memory(memory_list_t* memoryList, process_t* process) {
-    Node* current = memoryList->list->head;
-    memory_fragment_t* fragment = NULL;
-    while (current) {
-        fragment = (memory_fragment_t*)current->data;
-        if (fragment->type == PROCESS_FRAGMENT) {
-            if (fragment->pid == process->pid && fragment->load_time > 0) {
-                fragment->load_time -= 1;
-                fprintf(stderr, "<Scheduler> Loading pages for process %lld ETA: %lld ticks\n", process->pid, fragment->load_time);
-            }
-        }
-        current = current->next;
+    memory_fragment_t* fragment = get_fragment(memoryList, process);
+    if (fragment && fragment->load_time > 0) {
+        fragment->load_time -= 1;
+        fprintf(stderr, "<Scheduler> Loading pages for process %lld ETA: %lld ticks\n", process->pid, fragment->load_time);
+    }
+}
+
+/**
+ * Simulates loading pages from disk to memory over a number of ticks
+ * @param memoryList
+ * @param process
+ * @param ticks
+ */
+void swapping_load_memory_ticks(memory_list_t* memoryList, process_t* process, long long int ticks) {
+    memory_fragment_t* fragment = get_fragment(memoryList, process);
+    if (fragment && fragment->load_time > 0) {
+        fragment->load_time -= fragment->load_time < ticks ? fragment->load_time : ticks;
+        fprintf(stderr, "<Scheduler> Loading pages for process %lld ETA: %lld ticks\n", process->pid, fragment->load_time);
     }
 }
 
@@ -183,6 +193,8 @@ void deallocate_memory_fragment(Node* nodeToFree) {
 
 /**
  * Merge a hole fragment with the previous fragment.
+ * Both fragments must have been removed from the hole index.
+ * Holes have no pid, so the pid map is unaffected.
  * @param memoryList
  * @param nodeToEvict
  * @return
@@ -203,7 +215,9 @@ Node* join_prev(memory_list_t* memoryList, Node* nodeToEvict) {
     long long int total_size = prevFragment->byte_length + fragmentToEvict->byte_length;
     prevFragment->byte_length = total_size;
     /* Update total page length*/
+    memoryList->total_pages -= prevFragment->page_length + fragmentToEvict->page_length;
     prevFragment->page_length = byteToAvailablePage(total_size, memoryList->page_size);
+    memoryList->total_pages += prevFragment->page_length;
     Node* merged = nodeToEvict->prev;
     /* Free this memory fragment*/
     dlist_remove(memoryList->list, nodeToEvict);
@@ -212,6 +226,8 @@ Node* join_prev(memory_list_t* memoryList, Node* nodeToEvict) {
 
 /**
  * Merge a hole fragment with the next fragment.
+ * Both fragments must have been removed from the hole index.
+ * Holes have no pid, so the pid map is unaffected.
  * @param memoryList
  * @param nodeToEvict
  * @return
@@ -234,7 +250,9 @@ Node* join_next(memory_list_t* memoryList, Node* nodeToEvict) {
     long long int total_size = fragmentToEvict->byte_length + nextFragment->byte_length;
     fragmentToEvict->byte_length = total_size;
     /* Update total page length*/
+    memoryList->total_pages -= fragmentToEvict->page_length + nextFragment->page_length;
     fragmentToEvict->page_length = byteToAvailablePage(total_size, memoryList->page_size);
+    memoryList->total_pages += fragmentToEvict->page_length;
     Node* merged = nodeToEvict;
     /* Free the next fragment*/
     dlist_remove(memoryList->list, nodeToEvict->next);
@@ -242,31 +260,13 @@ Node* join_next(memory_list_t* memoryList, Node* nodeToEvict) {
 }
 
 /**
- * Find the memory fragment that is the least recently executed
+ * Find the memory fragment that is the least recently executed.
+ * Ties go to the fragment closest to the head of the list.
  * @param memoryList
  * @return A code pointer containing the fragment
  */
 Node* find_least_recently_used(memory_list_t* memoryList) {
-    Node* current = memoryList->list->head;
-    memory_fragment_t* fragment = NULL;
-    Node* nodeToSwap = NULL;
-    long long int minLastAccess;
-
-    while (current) {
-        fragment = (memory_fragment_t*)current->data;
-        if (fragment->type == PROCESS_FRAGMENT) {
-            if (!nodeToSwap) {
-                minLastAccess = fragment->last_access;
-                nodeToSwap = current;
-            }
-            if (fragment->last_access < minLastAccess){
-                minLastAccess = fragment->last_access;
-                nodeToSwap = current;
-            }
-        }
-        current = current->next;
-    }
-    return nodeToSwap;
+    return recency_heap_min(memoryList->recency);
 }
 
 /**
@@ -279,12 +279,16 @@ Node* evict(memory_list_t* memoryList, Node* nodeToEvict) {
     Node* merged = nodeToEvict;
     memory_fragment_t* fragmentToEvict = (memory_fragment_t*) nodeToEvict->data;
     assert(fragmentToEvict->type == PROCESS_FRAGMENT);
+    pid_map_remove(memoryList->fragments, fragmentToEvict->pid);
+    recency_heap_remove(memoryList->recency, nodeToEvict);
+    memoryList->pages_in_use -= fragmentToEvict->page_length;
     /* Deallocate the memory fragment */
     deallocate_memory_fragment(merged);
     /* Merge with the previous fragment if it exists and it's empty too */
     if (merged->prev) {
         memory_fragment_t* prevFragment = (memory_fragment_t*) merged->prev->data;
         if (prevFragment->type == HOLE_FRAGMENT) {
+            hole_index_remove(memoryList->holes, merged->prev);
             merged = join_prev(memoryList, merged);
         }
     }
@@ -292,9 +296,11 @@ Node* evict(memory_list_t* memoryList, Node* nodeToEvict) {
     if (merged->next) {
         memory_fragment_t *nextFragment = (memory_fragment_t *) merged->next->data;
         if (nextFragment->type == HOLE_FRAGMENT) {
+            hole_index_remove(memoryList->holes, merged->next);
             merged = join_next(memoryList, merged);
         }
     }
+    hole_index_insert(memoryList->holes, merged);
     /* Returns the free space */
     return merged;
 }
@@ -322,7 +328,7 @@ Node* swapping_allocate_memory(memory_list_t* memoryList, process_t* process, lo
         if (toEvict) {
             memory_fragment_t* fragment = (memory_fragment_t*)toEvict->data;
             long long int page_to_free = fragment->page_length;
-            long long int* addr_to_print = malloc(sizeof(*addr_to_print) * page_to_free);
+            long long int* addr_to_print = pool_alloc(sizeof(*addr_to_print) * page_to_free);
             long long int index = 0;
             for (long long int i=0; i<fragment->page_length; i++) {
                 addr_to_print[index++] = fragment->page_start + i;
@@ -330,7 +336,7 @@ Node* swapping_allocate_memory(memory_list_t* memoryList, process_t* process, lo
             printf("%lld, EVICTED, mem-addresses=", clock);
             print_memory(addr_to_print, fragment->page_length);
             printf("\n");
-            free(addr_to_print);
+            pool_free(addr_to_print, sizeof(*addr_to_print) * page_to_free);
             evict(memoryList, toEvict);
             freeSpace = first_fit(memoryList, process);
         } else {
@@ -341,15 +347,28 @@ Node* swapping_allocate_memory(memory_list_t* memoryList, process_t* process, lo
     return allocate(memoryList, freeSpace, process);
 }
 
-memory_fragment_t* get_fragment(memory_list_t* memoryList, process_t* process) {
-    Node* current = memoryList->list->head;
+/**
+ * Returns the list node of the fragment allocated to a process.
+ * NULL if the process is not in memory.
+ * @param memoryList
+ * @param pid
+ * @return
+ */
+Node* get_fragment_node(memory_list_t* memoryList, long long int pid) {
+    return (Node*)pid_map_get(memoryList->fragments, pid);
+}
 
-    while (current) {
-        memory_fragment_t* fragment = (memory_fragment_t*)current->data;
-        if (fragment->type == PROCESS_FRAGMENT && fragment->pid == process->pid) {
-            return fragment;
-        }
-        current = current->next;
+/**
+ * Returns the fragment allocated to a process.
+ * NULL if the process is not in memory.
+ * @param memoryList
+ * @param process
+ * @return
+ */
+memory_fragment_t* get_fragment(memory_list_t* memoryList, process_t* process) {
+    Node* node = get_fragment_node(memoryList, process->pid);
+    if (node) {
+        return (memory_fragment_t*)node->data;
     }
     return NULL;
 }
@@ -363,8 +382,25 @@ memory_fragment_t* get_fragment(memory_list_t* memoryList, process_t* process) {
  */
 void swapping_use_memory(memory_list_t* memoryList, process_t* process, long long int clock) {
     assert(memoryList && process);
-    memory_fragment_t* fragment = get_fragment(memoryList, process);
+    Node* node = get_fragment_node(memoryList, process->pid);
+    memory_fragment_t* fragment = (memory_fragment_t*)node->data;
     fragment->last_access = clock;
+    recency_heap_update(memoryList->recency, node);
+}
+
+/**
+ * Simulate the use of memory over a number of ticks starting from clock.
+ * @param memoryList
+ * @param process
+ * @param clock
+ * @param ticks
+ */
+void swapping_use_memory_ticks(memory_list_t* memoryList, process_t* process, long long int clock, long long int ticks) {
+    assert(memoryList && process);
+    Node* node = get_fragment_node(memoryList, process->pid);
+    memory_fragment_t* fragment = (memory_fragment_t*)node->data;
+    fragment->last_access = clock + ticks - 1;
+    recency_heap_update(memoryList->recency, node);
 }
 
 /**
@@ -394,35 +430,25 @@ void swapping_process_info(memory_list_t* memoryList, process_t* process, long l
 void swapping_print_addresses(memory_list_t* memoryList, process_t* process) {
     assert(memoryList && process);
     memory_fragment_t* fragment = get_fragment(memoryList, process);
-    long long int* addr_to_print = malloc(sizeof(*addr_to_print) * fragment->page_length);
+    long long int* addr_to_print = pool_alloc(sizeof(*addr_to_print) * fragment->page_length);
     long long int index = 0;
     for (long long int i=0; i<fragment->page_length; i++) {
         addr_to_print[index++] = fragment->page_start + i;
     }
     print_memory(addr_to_print, fragment->page_length);
-    free(addr_to_print);
+    pool_free(addr_to_print, sizeof(*addr_to_print) * fragment->page_length);
 }
 
 /**
  * Return memory usage in percentage.
+ * Page totals are kept up to date by allocate, evict and the joins, so no scan is needed.
  * @param memoryList
  * @param process
  * @return
  */
 long long int swapping_memory_usage(memory_list_t* memoryList, process_t* process) {
     assert(memoryList && process);
-    long long int total = 0;
-    long long int in_use = 0;
-    Node* current = memoryList->list->head;
-    while (current) {
-        memory_fragment_t* fragment = (memory_fragment_t*)current->data;
-        if (fragment->type == PROCESS_FRAGMENT) {
-            in_use+=fragment->page_length;
-        }
-        total+=fragment->page_length;
-        current = current->next;
-    }
-    return ceil((double)in_use * 100 /(double)total);
+    return ceil((double)memoryList->pages_in_use * 100 /(double)memoryList->total_pages);
 }
 
 /**
@@ -433,24 +459,20 @@ long long int swapping_memory_usage(memory_list_t* memoryList, process_t* proces
  */
 void swapping_free_memory(memory_list_t* memoryList, process_t* process, long long int clock) {
     assert(memoryList && process);
-    Node* current = memoryList->list->head;
-    while (current) {
+    Node* current = get_fragment_node(memoryList, process->pid);
+    if (current) {
         memory_fragment_t* fragment = (memory_fragment_t*)current->data;
-        if (fragment->type == PROCESS_FRAGMENT && fragment->pid == process->pid) {
-            long long int page_to_free = fragment->page_length;
-            long long int* addr_to_print = malloc(sizeof(*addr_to_print) * page_to_free);
-            long long int index = 0;
-            for (long long int i=0; i<fragment->page_length; i++) {
-                addr_to_print[index++] = fragment->page_start + i;
-            }
-            printf("%lld, EVICTED, mem-addresses=", clock);
-            print_memory(addr_to_print, fragment->page_length);
-            printf("\n");
-            free(addr_to_print);
-            current = evict(memoryList, current);
-        } else {
-            current = current->next;
-        };
+        long long int page_to_free = fragment->page_length;
+        long long int* addr_to_print = pool_alloc(sizeof(*addr_to_print) * page_to_free);
+        long long int index = 0;
+        for (long long int i=0; i<fragment->page_length; i++) {
+            addr_to_print[index++] = fragment->page_start + i;
+        }
+        printf("%lld, EVICTED, mem-addresses=", clock);
+        print_memory(addr_to_print, fragment->page_length);
+        printf("\n");
+        pool_free(addr_to_print, sizeof(*addr_to_print) * page_to_free);
+        evict(memoryList, current);
     }
 }
 
@@ -462,13 +484,8 @@ void swapping_free_memory(memory_list_t* memoryList, process_t* process, long lo
  */
 long long int swapping_require_allocation(memory_list_t* memoryList, process_t* process) {
     assert(memoryList && process);
-    Node* current = memoryList->list->head;
-    while (current) {
-        memory_fragment_t* fragment = (memory_fragment_t*)current->data;
-        if (fragment->type == PROCESS_FRAGMENT && fragment->pid == process->pid) {
-            return 0;
-        }
-        current = current->next;
+    if (get_fragment_node(memoryList, process->pid)) {
+        return 0;
     }
     return -1;
 }
@@ -499,6 +516,8 @@ memory_allocator_t* create_swapping_allocator(long long int memory_size, long lo
     allocator->use = (void (*)(void *, process_t *, long long int)) swapping_use_memory;
     allocator->free = (void (*)(void *, process_t *, long long int)) swapping_free_memory;
     allocator->load = (void (*)(void *, process_t *)) swapping_load_memory;
+    allocator->use_ticks = (void (*)(void *, process_t *, long long int, long long int)) swapping_use_memory_ticks;
+    allocator->load_ticks = (void (*)(void *, process_t *, long long int)) swapping_load_memory_ticks;
     allocator->load_time_left = (long long int (*)(void *, process_t *)) swapping_load_time_left;
     allocator->require_allocation = (long long int (*)(void *, process_t *)) swapping_require_allocation;
     allocator->page_fault = (long long int (*)(void *, process_t *)) swapping_page_fault;
@@ -13,6 +13,9 @@
 #include <stdio.h>
 #include <stdbool.h>
 #include "memory_allocator.h"
+#include "hole_index.h"
+#include "pid_map.h"
+#include "recency_heap.h"
 #include "../test/swapping_test.h"
 #include "virtual_memory.h"
 #include "scheduler.h"
@@ -21,6 +24,16 @@
 typedef struct memory_list {
     Dlist* list;
     long long int page_size;
+    /* Index of hole fragments in list for first fit */
+    hole_index_t* holes;
+    /* Maps pid to the list node of its process fragment */
+    pid_map_t* fragments;
+    /* Process fragments ordered by last access for LRU eviction */
+    recency_heap_t* recency;
+    /* Sum of page lengths of all fragments, holes included */
+    long long int total_pages;
+    /* Sum of page lengths of process fragments */
+    long long int pages_in_use;
 } memory_list_t;
 
 long long int swapping_load_time_left(memory_list_t* memoryList, process_t* process);
@@ -33,6 +46,10 @@ void print_memory_list(memory_list_t* memoryList);
 Node* evict(memory_list_t* memoryList, Node* nodeToEvict);
 Node* find_least_recently_used(memory_list_t* memoryList);
 void swapping_use_memory(memory_list_t* memoryList, process_t* process, long long int clock);
+void swapping_use_memory_ticks(memory_list_t* memoryList, process_t* process, long long int clock, long long int ticks);
+void swapping_load_memory_ticks(memory_list_t* memoryList, process_t* process, long long int ticks);
+memory_fragment_t* get_fragment(memory_list_t* memoryList, process_t* process);
+Node* get_fragment_node(memory_list_t* memoryList, long long int pid);
 Node* swapping_allocate_memory(memory_list_t* memoryList, process_t* process, long long int clock);
 void swapping_free_memory(memory_list_t* memoryList, process_t* process, long long int clock);
 long long int byteToRequiredPage(long long int bytes, long long int page_size);
@@ -0,0 +1,249 @@
+/**
+ * Binary trace module
+ * Converts text workloads to a columnar binary format and reads them back through mmap.
+ */
+
+#include "trace.h"
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/**
+ * A growable byte buffer used to build a column
+ */
+typedef struct byte_buffer {
+    unsigned char* bytes;
+    size_t size;
+    size_t capacity;
+} byte_buffer_t;
+
+/**
+ * Append a value to a buffer as an unsigned LEB128 varint
+ * @param buffer
+ * @param value
+ */
+static void put_varint(byte_buffer_t* buffer, uint64_t value) {
+    /* A 64 bit value takes at most 10 bytes */
+    if (buffer->size + 10 > buffer->capacity) {
+        buffer->capacity = buffer->capacity ? buffer->capacity * 2 : 4096;
+        buffer->bytes = realloc(buffer->bytes, buffer->capacity);
+        assert(buffer->bytes);
+    }
+    while (value >= 0x80) {
+        buffer->bytes[buffer->size++] = (unsigned char)(value | 0x80);
+        value >>= 7;
+    }
+    buffer->bytes[buffer->size++] = (unsigned char)value;
+}
+
+/**
+ * Read an unsigned LEB128 varint, advancing the pointer past it.
+ * Exits if the varint runs past the end of its column.
+ * @param pointer
+ * @param end
+ * @return
+ */
+static uint64_t get_varint(const unsigned char** pointer, const unsigned char* end) {
+    uint64_t value = 0;
+    int shift = 0;
+    const unsigned char* p = *pointer;
+    while (p < end && shift < 64) {
+        unsigned char byte = *p++;
+        value |= (uint64_t)(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            *pointer = p;
+            return value;
+        }
+        shift += 7;
+    }
+    fprintf(stderr, "Corrupted trace: truncated column\n");
+    exit(EXIT_FAILURE);
+}
+
+/**
+ * Map signed integers to unsigned ones so that small negative deltas stay short
+ */
+static uint64_t zigzag_encode(long long int value) {
+    return ((uint64_t)value << 1) ^ (uint64_t)(value >> 63);
+}
+
+static long long int zigzag_decode(uint64_t value) {
+    return (long long int)(value >> 1) ^ -(long long int)(value & 1);
+}
+
+/**
+ * Returns if a file starts with the binary trace magic
+ * @param fileName
+ * @return
+ */
+bool is_binary_trace(char* fileName) {
+    char magic[4];
+    FILE* fp = fopen(fileName, "rb");
+    if (fp == NULL) {
+        return false;
+    }
+    bool binary = fread(magic, 1, sizeof(magic), fp) == sizeof(magic) && memcmp(magic, TRACE_MAGIC, sizeof(magic)) == 0;
+    fclose(fp);
+    return binary;
+}
+
+/**
+ * Map a binary trace into memory and validate its header
+ * @param fileName
+ * @return
+ */
+trace_t* open_trace(char* fileName) {
+    int fd = open(fileName, O_RDONLY);
+    if (fd < 0) {
+        perror("Error while opening the file.\n");
+        exit(EXIT_FAILURE);
+    }
+    struct stat st;
+    if (fstat(fd, &st) < 0) {
+        perror("Error while reading the file.\n");
+        exit(EXIT_FAILURE);
+    }
+    if ((size_t)st.st_size < sizeof(trace_header_t)) {
+        fprintf(stderr, "Corrupted trace: file too short\n");
+        exit(EXIT_FAILURE);
+    }
+    unsigned char* data = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        perror("Error while mapping the file.\n");
+        exit(EXIT_FAILURE);
+    }
+    /* Records are decoded front to back exactly once */
+    madvise(data, st.st_size, MADV_SEQUENTIAL);
+
+    trace_header_t header;
+    memcpy(&header, data, sizeof(header));
+    if (memcmp(header.magic, TRACE_MAGIC, sizeof(header.magic)) != 0 || header.version != TRACE_VERSION) {
+        fprintf(stderr, "Corrupted trace: unknown format\n");
+        exit(EXIT_FAILURE);
+    }
+    for (int i=0; i<TRACE_COLUMNS; i++) {
+        if (header.column_offset[i] < sizeof(header) || header.column_offset[i] > header.column_offset[i+1]) {
+            fprintf(stderr, "Corrupted trace: bad column offset\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+    if (header.column_offset[TRACE_COLUMNS] != (uint64_t)st.st_size) {
+        fprintf(stderr, "Corrupted trace: bad file size\n");
+        exit(EXIT_FAILURE);
+    }
+
+    trace_t* trace = malloc(sizeof(*trace));
+    assert(trace);
+    trace->data = data;
+    trace->size = st.st_size;
+    trace->record_count = header.record_count;
+    return trace;
+}
+
+/**
+ * Unmap a binary trace
+ * @param trace
+ */
+void close_trace(trace_t* trace) {
+    assert(trace);
+    munmap(trace->data, trace->size);
+    free(trace);
+}
+
+/**
+ * Position a cursor at the first record of a trace
+ * @param trace
+ * @param cursor
+ */
+void trace_cursor_init(trace_t* trace, trace_cursor_t* cursor) {
+    trace_header_t header;
+    memcpy(&header, trace->data, sizeof(header));
+    for (int i=0; i<TRACE_COLUMNS; i++) {
+        cursor->column[i] = trace->data + header.column_offset[i];
+        cursor->column_end[i] = trace->data + header.column_offset[i+1];
+    }
+    cursor->time = 0;
+    cursor->remaining = trace->record_count;
+}
+
+/**
+ * Decode the next record straight from the mapped columns
+ * @param cursor
+ * @param time
+ * @param pid
+ * @param memory
+ * @param jobTime
+ * @return false if all records have been read
+ */
+bool trace_next(trace_cursor_t* cursor, long long int* time, long long int* pid, long long int* memory, long long int* jobTime) {
+    if (cursor->remaining == 0) {
+        return false;
+    }
+    cursor->time += zigzag_decode(get_varint(&cursor->column[TRACE_COLUMN_TIME], cursor->column_end[TRACE_COLUMN_TIME]));
+    *time = cursor->time;
+    *pid = (long long int)get_varint(&cursor->column[TRACE_COLUMN_PID], cursor->column_end[TRACE_COLUMN_PID]);
+    *memory = (long long int)get_varint(&cursor->column[TRACE_COLUMN_MEMORY], cursor->column_end[TRACE_COLUMN_MEMORY]);
+    *jobTime = (long long int)get_varint(&cursor->column[TRACE_COLUMN_JOB_TIME], cursor->column_end[TRACE_COLUMN_JOB_TIME]);
+    cursor->remaining--;
+    return true;
+}
+
+/**
+ * Convert a text workload into a binary trace
+ * @param textFile
+ * @param binaryFile
+ * @return number of records converted, -1 if a file could not be read or written
+ */
+long long int convert_trace(char* textFile, char* binaryFile) {
+    assert(textFile && binaryFile);
+    FILE* in = fopen(textFile, "r");
+    if (in == NULL) {
+        perror(textFile);
+        return -1;
+    }
+    byte_buffer_t columns[TRACE_COLUMNS];
+    memset(columns, 0, sizeof(columns));
+
+    long long int count = 0;
+    long long int last_time = 0;
+    long long int time, pid, memory, jobTime;
+    while (fscanf(in, "%lld %lld %lld %lld\n", &time, &pid, &memory, &jobTime) == 4) {
+        put_varint(&columns[TRACE_COLUMN_TIME], zigzag_encode(time - last_time));
+        put_varint(&columns[TRACE_COLUMN_PID], (uint64_t)pid);
+        put_varint(&columns[TRACE_COLUMN_MEMORY], (uint64_t)memory);
+        put_varint(&columns[TRACE_COLUMN_JOB_TIME], (uint64_t)jobTime);
+        last_time = time;
+        count++;
+    }
+    fclose(in);
+
+    trace_header_t header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, TRACE_MAGIC, sizeof(header.magic));
+    header.version = TRACE_VERSION;
+    header.record_count = count;
+    header.column_offset[0] = sizeof(header);
+    for (int i=0; i<TRACE_COLUMNS; i++) {
+        header.column_offset[i+1] = header.column_offset[i] + columns[i].size;
+    }
+
+    FILE* out = fopen(binaryFile, "wb");
+    bool written = out != NULL && fwrite(&header, sizeof(header), 1, out) == 1;
+    for (int i=0; i<TRACE_COLUMNS; i++) {
+        if (written && columns[i].size) {
+            written = fwrite(columns[i].bytes, 1, columns[i].size, out) == columns[i].size;
+        }
+        free(columns[i].bytes);
+    }
+    if (out != NULL && fclose(out) != 0) {
+        written = false;
+    }
+    if (!written) {
+        perror(binaryFile);
+        return -1;
+    }
+    return count;
+}
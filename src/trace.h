@@ -0,0 +1,57 @@
+/**
+ * Binary trace module.
+ * A compact columnar format for workloads, loaded with mmap.
+ *
+ * Layout: a fixed size header followed by four columns, each of them a run of varints
+ *  - arrival time, delta encoded against the previous record (zigzag, may be negative)
+ *  - pid
+ *  - memory
+ *  - job time
+ */
+
+#ifndef SCHEDULER_TRACE_H
+#define SCHEDULER_TRACE_H
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <assert.h>
+
+#define TRACE_MAGIC "SCHT"
+#define TRACE_VERSION 1
+#define TRACE_COLUMNS 4
+#define TRACE_COLUMN_TIME 0
+#define TRACE_COLUMN_PID 1
+#define TRACE_COLUMN_MEMORY 2
+#define TRACE_COLUMN_JOB_TIME 3
+
+typedef struct trace_header {
+    char magic[4];
+    uint32_t version;
+    uint64_t record_count;
+    /* Offset of each column from the start of the file, the last one marks the end of file */
+    uint64_t column_offset[TRACE_COLUMNS + 1];
+} trace_header_t;
+
+typedef struct trace {
+    unsigned char* data;
+    size_t size;
+    long long int record_count;
+} trace_t;
+
+typedef struct trace_cursor {
+    const unsigned char* column[TRACE_COLUMNS];
+    const unsigned char* column_end[TRACE_COLUMNS];
+    long long int time;
+    long long int remaining;
+} trace_cursor_t;
+
+bool is_binary_trace(char* fileName);
+trace_t* open_trace(char* fileName);
+void close_trace(trace_t* trace);
+void trace_cursor_init(trace_t* trace, trace_cursor_t* cursor);
+bool trace_next(trace_cursor_t* cursor, long long int* time, long long int* pid, long long int* memory, long long int* jobTime);
+long long int convert_trace(char* textFile, char* binaryFile);
+
+#endif //SCHEDULER_TRACE_H
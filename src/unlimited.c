@@ -37,6 +37,17 @@ void unlimited_free_memory(void* structure, process_t* process, long long int cl
 
 };
 
+/**
+ * Simulates the reference to memory over a number of ticks.
+ * Do nothing for unlimited memory.
+ * @param structure
+ * @param process
+ * @param clock
+ * @param ticks
+ */
+void unlimited_use_memory_ticks(void* structure, process_t* process, long long int clock, long long int ticks) {
+
+};
 
 long long int unlimited_load_time_left(void* structure, process_t* process) {
     return 0;
@@ -49,6 +60,16 @@ long long int unlimited_load_time_left(void* structure, process_t* process) {
  */
 void unlimited_load_memory(void* structure, process_t* process) {
 
+};
+/**
+ * Simulate the process of loading pages over a number of ticks.
+ * Do nothing since no loading is required.
+ * @param structure
+ * @param process
+ * @param ticks
+ */
+void unlimited_load_memory_ticks(void* structure, process_t* process, long long int ticks) {
+
 };
 /**
  * Returns if a process has been allocated all memory it requires.
@@ -95,6 +116,8 @@ memory_allocator_t* create_unlimited_allocator() {
     allocator->use = unlimited_use_memory;
     allocator->free = unlimited_free_memory;
     allocator->load = unlimited_load_memory;
+    allocator->use_ticks = unlimited_use_memory_ticks;
+    allocator->load_ticks = unlimited_load_memory_ticks;
     allocator->load_time_left = unlimited_load_time_left;
     allocator->require_allocation = unlimited_require_allocation;
     allocator->page_fault = unlimited_page_fault;
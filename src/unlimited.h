@@ -13,5 +13,7 @@ void* unlimited_allocate_memory(void* structure, process_t* process, long long i
 void unlimited_free_memory(void* structure, process_t* process, long long int clock);
 long long int unlimited_load_time_left(void* structure, process_t* process);
 void unlimited_load_memory(void* structure, process_t* process);
+void unlimited_use_memory_ticks(void* structure, process_t* process, long long int clock, long long int ticks);
+void unlimited_load_memory_ticks(void* structure, process_t* process, long long int ticks);
 memory_allocator_t* create_unlimited_allocator();
 #endif //SCHEDULER_UNLIMITED_H
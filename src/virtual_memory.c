@@ -3,6 +3,7 @@
  * Created by Haswell on 18/05/2020.
  */
 
+#include <string.h>
 #include "virtual_memory.h"
 
 /**
@@ -12,19 +13,26 @@
  * @return
  */
 page_table_node_t* create_page_table_node(long long int pid, long long int page_count) {
-    page_table_node_t* page = (page_table_node_t*)malloc(sizeof(*page));
+    page_table_node_t* page = (page_table_node_t*)pool_alloc(sizeof(*page));
     assert(page);
     page->page_count = page_count;
     page->pid = pid;
     page->valid_page_count = 0;
     page->loading_time_left = 0;
-    page->page_table_pointer = malloc(sizeof(*page->page_table_pointer) * page_count);
+    page->page_table_pointer = pool_alloc(sizeof(*page->page_table_pointer) * page_count);
     assert(page->page_table_pointer);
     page->last_access = -1;
+    page->resident_frames = NULL;
+    page->resident_capacity = 0;
+    page->next_use = NEVER_USED;
+    page->furthest_index = -1;
+    page->created = 0;
+    page->references = 0;
     for (long long int i=0; i<page_count; i++) {
         page->page_table_pointer[i].frame_number = -1;
         page->page_table_pointer[i].reference = 0;
         page->page_table_pointer[i].validity = 0;
+        page->page_table_pointer[i].ghost = -1;
     }
     return page;
 }
@@ -35,8 +43,9 @@ page_table_node_t* create_page_table_node(long long int pid, long long int page_
  */
 void free_page_table_node(page_table_node_t* page_table) {
     assert(page_table);
-    free(page_table->page_table_pointer);
-    free(page_table);
+    pool_free(page_table->page_table_pointer, sizeof(*page_table->page_table_pointer) * page_table->page_count);
+    free(page_table->resident_frames);
+    pool_free(page_table, sizeof(*page_table));
 }
 
 /**
@@ -45,8 +54,7 @@ void free_page_table_node(page_table_node_t* page_table) {
  */
 void dlist_free_page_table_node(void* page_table) {
     assert(page_table);
-    free(((page_table_node_t*)page_table)->page_table_pointer);
-    free(page_table);
+    free_page_table_node((page_table_node_t*)page_table);
 }
 
 /**
@@ -56,34 +64,172 @@ void dlist_free_page_table_node(void* page_table) {
  * @param process
  */
 void virtual_memory_load_process(virtual_memory_t* memory_manager, process_t* process) {
-    Node* current = memory_manager->page_tables->head;
-    while (current) {
-        page_table_node_t* page_table = (page_table_node_t*)current->data;
-        if (page_table->pid == process->pid) {
-            page_table->loading_time_left -= 1;
-            fprintf(stderr, "Process %lld is loading. ETA: %lld ticks\n", process->pid, page_table->loading_time_left);
-            return;
+    page_table_node_t* page_table = get_page_table(memory_manager, process->pid);
+    if (page_table) {
+        page_table->loading_time_left -= 1;
+        fprintf(stderr, "Process %lld is loading. ETA: %lld ticks\n", process->pid, page_table->loading_time_left);
+    }
+}
+
+/**
+ * Simulates loading pages from disk to memory over a number of ticks.
+ * @param memory_manager
+ * @param process
+ * @param ticks
+ */
+void virtual_memory_load_process_ticks(virtual_memory_t* memory_manager, process_t* process, long long int ticks) {
+    page_table_node_t* page_table = get_page_table(memory_manager, process->pid);
+    assert(page_table);
+    page_table->loading_time_left -= ticks;
+    fprintf(stderr, "Process %lld is loading. ETA: %lld ticks\n", process->pid, page_table->loading_time_left);
+}
+
+/**
+ * Set the reference bit of a frame
+ * @param memory_manager
+ * @param frame_number
+ */
+static void reference_frame(virtual_memory_t* memory_manager, long long int frame_number) {
+    uint8_t bit = (uint8_t)(1u << (frame_number % 8));
+    if (!(memory_manager->reference_bits[frame_number / 8] & bit)) {
+        memory_manager->reference_bits[frame_number / 8] |= bit;
+        if (memory_manager->ages_counters) {
+            memory_manager->referenced_frames[memory_manager->referenced_count++] = frame_number;
         }
-        current = current->next;
     }
 }
 
+/**
+ * Clear the reference bit of a frame
+ * @param memory_manager
+ * @param frame_number
+ * @return the bit before it was cleared
+ */
+static long long int take_frame_reference(virtual_memory_t* memory_manager, long long int frame_number) {
+    uint8_t bit = (uint8_t)(1u << (frame_number % 8));
+    long long int referenced = (memory_manager->reference_bits[frame_number / 8] & bit) != 0;
+    memory_manager->reference_bits[frame_number / 8] &= (uint8_t)~bit;
+    return referenced;
+}
+
+/**
+ * Clear the counter of a frame
+ * @param memory_manager
+ * @param frame_number
+ */
+static void reset_counter(virtual_memory_t* memory_manager, long long int frame_number) {
+    memory_manager->counter[frame_number] = 0;
+    memory_manager->aged_at[frame_number] = memory_manager->epoch;
+}
+
+/**
+ * Let the LFU index know the counter of an occupied frame has changed
+ * @param memory_manager
+ * @param frame_number
+ */
+static void track_counter(virtual_memory_t* memory_manager, long long int frame_number) {
+    if (memory_manager->frequencies) {
+        lfu_index_track(memory_manager->frequencies, frame_number, memory_manager->counter[frame_number],
+                        memory_manager->aged_at[frame_number], memory_manager->epoch);
+    }
+}
+
+/**
+ * Let the LFU index know a frame is no longer occupied
+ * @param memory_manager
+ * @param frame_number
+ */
+static void untrack_counter(virtual_memory_t* memory_manager, long long int frame_number) {
+    if (memory_manager->frequencies) {
+        lfu_index_untrack(memory_manager->frequencies, frame_number);
+    }
+}
+
+/**
+ * Move on to a later aging tick. Counters that are not brought up to date owe the difference.
+ * @param memory_manager
+ * @param ticks
+ */
+static void advance_epoch(virtual_memory_t* memory_manager, long long int ticks) {
+    if (memory_manager->frequencies) {
+        lfu_index_advance(memory_manager->frequencies, memory_manager->epoch, memory_manager->epoch + ticks);
+    }
+    memory_manager->epoch += ticks;
+}
+
+/**
+ * Returns the counter of a frame, applying the aging it is owed
+ * @param memory_manager
+ * @param frame_number
+ * @return
+ */
+unsigned int frame_counter(virtual_memory_t* memory_manager, long long int frame_number) {
+    long long int owed = memory_manager->epoch - memory_manager->aged_at[frame_number];
+    memory_manager->counter[frame_number] >>= owed < MAX_AGING_SHIFT ? owed : MAX_AGING_SHIFT;
+    memory_manager->aged_at[frame_number] = memory_manager->epoch;
+    return memory_manager->counter[frame_number];
+}
+
+/**
+ * Add a frame to the resident frames of a process, keeping them in order
+ * @param page_table
+ * @param frame_number
+ */
+static void add_resident_frame(page_table_node_t* page_table, long long int frame_number) {
+    long long int count = page_table->valid_page_count;
+    if (count == page_table->resident_capacity) {
+        page_table->resident_capacity = page_table->resident_capacity ? page_table->resident_capacity * 2 : MIN_PAGE_REQUIRED_TO_RUN;
+        page_table->resident_frames = realloc(page_table->resident_frames, sizeof(*page_table->resident_frames) * page_table->resident_capacity);
+        assert(page_table->resident_frames);
+    }
+    /* Frames are handed out lowest first, so the new frame usually belongs near the end */
+    long long int i = count;
+    while (i > 0 && page_table->resident_frames[i - 1] > frame_number) {
+        page_table->resident_frames[i] = page_table->resident_frames[i - 1];
+        i--;
+    }
+    page_table->resident_frames[i] = frame_number;
+}
+
+/**
+ * Remove a frame from the resident frames of a process
+ * @param page_table
+ * @param frame_number
+ */
+static void remove_resident_frame(page_table_node_t* page_table, long long int frame_number) {
+    long long int count = page_table->valid_page_count;
+    /* Binary search for the frame */
+    long long int low = 0, high = count;
+    while (low < high) {
+        long long int mid = low + (high - low) / 2;
+        if (page_table->resident_frames[mid] < frame_number) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    assert(low < count && page_table->resident_frames[low] == frame_number);
+    memmove(page_table->resident_frames + low, page_table->resident_frames + low + 1,
+            sizeof(*page_table->resident_frames) * (count - low - 1));
+}
+
 /**
  * Create a mapping from a frame number to a virtual address of a process.
  * @param page_table
  * @param frame_number
- * @return
+ * @return the page mapped into the frame, -1 if every page is already mapped
  */
 long long int map(page_table_node_t * page_table, long long int frame_number) {
     for (long long int i=0; i<page_table->page_count; i++) {
         if (page_table->page_table_pointer[i].validity == 0) {
             page_table->page_table_pointer[i].validity = 1;
             page_table->page_table_pointer[i].frame_number = frame_number;
+            add_resident_frame(page_table, frame_number);
             page_table->valid_page_count += 1;
-            return 1;
+            return i;
         }
     }
-    return 0;
+    return -1;
 }
 
 /**
@@ -110,12 +256,37 @@ virtual_memory_t* create_virtual_memory(long long int memory_size, long long int
     memory->page_size = page_size;
     memory->total_frame = memory_size/page_size;
     memory->free_frame = memory_size/page_size;
-    memory->page_tables = new_dlist(dlist_free_page_table_node, (void (*)(void *)) print_page_table);
+    memory->page_tables = new_intrusive_dlist(dlist_free_page_table_node, (void (*)(void *)) print_page_table);
+    memory->page_table_index = create_pid_map();
+    memory->free_frames = create_frame_bitmap(memory->total_frame, true);
+    memory->frame_owners = malloc(sizeof(*memory->frame_owners) * memory->total_frame);
+    assert(memory->frame_owners);
+    memory->reference_bits = calloc((memory->total_frame + 7) / 8, sizeof(*memory->reference_bits));
+    assert(memory->reference_bits);
+    memory->referenced_frames = malloc(sizeof(*memory->referenced_frames) * memory->total_frame);
+    memory->referenced_count = 0;
+    memory->aged_at = calloc(memory->total_frame, sizeof(*memory->aged_at));
+    memory->epoch = 0;
+    memory->frequencies = NULL;
+    memory->ages_counters = true;
+    memory->clock_hand = 0;
+    memory->now = 0;
+    memory->arc = NULL;
+    memory->schedule = NULL;
+    memory->furthest = NULL;
+    memory->generations = NULL;
+    memory->recency = NULL;
+    memory->page_table_count = 0;
+    memory->last_used = malloc(sizeof(*memory->last_used) * (memory->total_frame > 0 ? memory->total_frame : 1));
+    assert(memory->last_used);
+    assert(memory->referenced_frames && memory->aged_at);
     memory->page_frames = malloc(sizeof(memory->page_frames) * memory->total_frame);
     memory->counter = malloc(sizeof(memory->counter) * memory->total_frame);
     for (long long int i=0; i<memory->total_frame; i++) {
         memory->page_frames[i] = NOT_OCCUPIED;
         memory->counter[i] = 0;
+        memory->frame_owners[i].page_table = NULL;
+        memory->frame_owners[i].page = -1;
     }
     return memory;
 }
@@ -127,6 +298,28 @@ virtual_memory_t* create_virtual_memory(long long int memory_size, long long int
 
 void free_memory(virtual_memory_t *memory_manager) {
     free_dlist(memory_manager->page_tables);
+    free_pid_map(memory_manager->page_table_index);
+    free_frame_bitmap(memory_manager->free_frames);
+    free(memory_manager->frame_owners);
+    free(memory_manager->reference_bits);
+    free(memory_manager->referenced_frames);
+    free(memory_manager->aged_at);
+    free(memory_manager->last_used);
+    if (memory_manager->frequencies) {
+        free_lfu_index(memory_manager->frequencies);
+    }
+    if (memory_manager->arc) {
+        free_arc_index(memory_manager->arc);
+    }
+    if (memory_manager->furthest) {
+        free_furthest_heap(memory_manager->furthest);
+    }
+    if (memory_manager->generations) {
+        free_generation_index(memory_manager->generations);
+    }
+    if (memory_manager->recency) {
+        free_lru_list(memory_manager->recency);
+    }
     free(memory_manager->page_frames);
     free(memory_manager->counter);
     free(memory_manager);
@@ -140,15 +333,22 @@ void free_memory(virtual_memory_t *memory_manager) {
  * @return
  */
 page_table_node_t* get_page_table(virtual_memory_t* memory_manager, long long int pid) {
-    Node* current = memory_manager->page_tables->head;
-    while (current) {
-        page_table_node_t* page_table = (page_table_node_t*)current->data;
-        if (pid == page_table->pid) {
-            return page_table;
-        }
-        current = current->next;
-    }
-    return NULL;
+    return (page_table_node_t*)pid_map_get(memory_manager->page_table_index, pid);
+}
+
+/**
+ * Create a page table for a process and register it with the memory manager
+ * @param memory_manager
+ * @param pid
+ * @param page_count
+ * @return
+ */
+page_table_node_t* add_page_table(virtual_memory_t* memory_manager, long long int pid, long long int page_count) {
+    page_table_node_t* page_table = create_page_table_node(pid, page_count);
+    page_table->created = memory_manager->page_table_count++;
+    dlist_link_end(memory_manager->page_tables, &page_table->node, page_table);
+    pid_map_put(memory_manager->page_table_index, pid, page_table);
+    return page_table;
 }
 
 /**
@@ -162,19 +362,40 @@ long long int allocate_all_free_memory(virtual_memory_t* memory_manager, process
     assert(page_table);
     long long int newly_allocated = 0;
     while (memory_manager->free_frame > 0 && page_table->valid_page_count < page_table->page_count) {
-        for (long long int i = 0; i < memory_manager->total_frame; i++) {
-            if (memory_manager->page_frames[i] == NOT_OCCUPIED) {
-                memory_manager->page_frames[i] = page_table->pid;
-                memory_manager->counter[i] = 0;
-                map(page_table, i);
-                memory_manager->free_frame -= 1;
-                newly_allocated++;
-                /* Increase loading time */
-                page_table->loading_time_left += LOADING_TIME_PER_PAGE;
-                /* Break the inner for loop to check if enough memory has been allocated */
-                break;
-            }
+        /* Frames are always handed out lowest first */
+        long long int i = frame_bitmap_lowest(memory_manager->free_frames);
+        assert(i >= 0 && memory_manager->page_frames[i] == NOT_OCCUPIED);
+        frame_bitmap_clear(memory_manager->free_frames, i);
+        memory_manager->page_frames[i] = page_table->pid;
+        reset_counter(memory_manager, i);
+        track_counter(memory_manager, i);
+        memory_manager->last_used[i] = memory_manager->now;
+        memory_manager->frame_owners[i].page_table = page_table;
+        memory_manager->frame_owners[i].page = map(page_table, i);
+        /* A page referenced while it was not resident carries its reference bit into the frame */
+        page_table_entry_t* entry = &page_table->page_table_pointer[memory_manager->frame_owners[i].page];
+        if (entry->reference) {
+            reference_frame(memory_manager, i);
+            entry->reference = 0;
+        }
+        if (memory_manager->arc) {
+            arc_index_insert(memory_manager->arc, i, &entry->ghost);
+        }
+        if (memory_manager->generations) {
+            generation_index_insert(memory_manager->generations, i);
         }
+        if (memory_manager->recency) {
+            lru_list_touch(memory_manager->recency, i);
+        }
+        /* The process can now be chosen by OPT */
+        if (memory_manager->furthest && page_table->valid_page_count == 1) {
+            page_table->next_use = next_use_of(memory_manager->schedule, page_table->pid);
+            furthest_heap_insert(memory_manager->furthest, page_table);
+        }
+        memory_manager->free_frame -= 1;
+        newly_allocated++;
+        /* Increase loading time */
+        page_table->loading_time_left += LOADING_TIME_PER_PAGE;
     }
     return newly_allocated;
 }
@@ -191,19 +412,17 @@ long long int LRU(virtual_memory_t* memory_manager, long long int ignore) {
 
 /**
  * returns a frame number to evict using least frequently used with aging.
+ * The victim is the process owning the frame with the lowest counter, the lowest frame on ties.
  * @param memory_manager
  * @param ignore
  * @return
  */
 long long int LFU(virtual_memory_t* memory_manager, long long int ignore) {
-    long long int victim_pid = -1;
-    long long int min_freq = INT_MAX;
-    for (long long int i=0; i<memory_manager->total_frame; i++) {
-        if (memory_manager->counter[i] < min_freq && memory_manager->page_frames[i] != ignore) {
-            min_freq = memory_manager->counter[i] < min_freq;
-            victim_pid = memory_manager->page_frames[i];
-        }
-    }
+    assert(memory_manager->frequencies);
+    long long int least_used = lfu_index_min(memory_manager->frequencies, memory_manager->counter, memory_manager->aged_at,
+                                             memory_manager->epoch, memory_manager->page_frames, ignore);
+    assert(least_used >= 0);
+    long long int victim_pid = memory_manager->page_frames[least_used];
 
     long long int frame_number = first_page(memory_manager, victim_pid);
     assert(frame_number>=0);
@@ -211,95 +430,258 @@ long long int LFU(virtual_memory_t* memory_manager, long long int ignore) {
 }
 
 /**
- * Allocate memory to a process. Evicting pages using LRU if memory is not sufficient.
+ * returns a frame number to evict using the adaptive replacement cache.
+ */
+long long int ARC(virtual_memory_t* memory_manager, long long int ignore) {
+    return arc_index_replace(memory_manager->arc, memory_manager->page_frames, ignore);
+}
+
+/**
+ * returns a frame number to evict using Belady's optimal algorithm.
+ * The victim is the process that runs again furthest in the future, going by the recorded schedule.
  * @param memory_manager
- * @param process
- * @param clock
+ * @param ignore
+ * @return
  */
-void virtual_memory_allocate_memory_LRU(virtual_memory_t* memory_manager, process_t* process, long long int clock) {
-    /* convert bytes to page counts */
-    long long int page_required = byteToRequiredPage(process->memory, memory_manager->page_size);
-    long long int allocation_target = page_required>MIN_PAGE_REQUIRED_TO_RUN?MIN_PAGE_REQUIRED_TO_RUN: page_required;
+long long int OPT(virtual_memory_t* memory_manager, long long int ignore) {
+    page_table_node_t* victim = furthest_heap_max(memory_manager->furthest, ignore);
+    assert(victim);
+    long long int frame_number = first_page(memory_manager, victim->pid);
+    assert(frame_number>=0);
+    return frame_number;
+}
 
-    page_table_node_t* allocated = get_page_table(memory_manager, process->pid);
+/**
+ * returns a frame number to evict using the multi-generational LRU, the oldest frame of the oldest generation.
+ * @param memory_manager
+ * @param ignore
+ * @return
+ */
+long long int MGLRU(virtual_memory_t* memory_manager, long long int ignore) {
+    long long int frame_number = generation_index_oldest(memory_manager->generations, memory_manager->page_frames, ignore);
+    assert(frame_number>=0);
+    return frame_number;
+}
 
-    /* Create a page table for the process if not exist */
-    if (!allocated) {
-        allocated = create_page_table_node(process->pid, page_required);
-        dlist_add_end(memory_manager->page_tables, allocated);
-    }
-    allocate_all_free_memory(memory_manager, process);
+/**
+ * returns a frame number to evict using least recently used pages, rather than processes.
+ * @param memory_manager
+ * @param ignore
+ * @return
+ */
+long long int page_LRU(virtual_memory_t* memory_manager, long long int ignore) {
+    long long int frame_number = lru_list_oldest(memory_manager->recency, memory_manager->page_frames, ignore);
+    assert(frame_number>=0);
+    return frame_number;
+}
 
-    /* The number of pages must be evicted to let the process run */
-    long long int evict_page_count = allocation_target - allocated->valid_page_count;
-    long long int* to_print = malloc(sizeof(*to_print) * evict_page_count);
-    long long int index = 0;
+/**
+ * Returns the frame under the clock hand and moves the hand to the next frame
+ * @param memory_manager
+ * @return
+ */
+static long long int advance_clock_hand(virtual_memory_t* memory_manager) {
+    long long int frame_number = memory_manager->clock_hand;
+    memory_manager->clock_hand = (frame_number + 1) % memory_manager->total_frame;
+    return frame_number;
+}
 
-    /* Evict pages if memory allocated isn't enough for execution */
-    while (allocated->valid_page_count < allocation_target){
-        long long int victim = LRU(memory_manager, allocated->pid);
+/**
+ * returns a frame number to evict using the CLOCK (second chance) algorithm.
+ * The hand sweeps the frames in a circle, clearing reference bits, and stops at the first frame
+ * that has not been referenced since the hand last passed it.
+ * @param memory_manager
+ * @param ignore
+ * @return
+ */
+long long int CLOCK(virtual_memory_t* memory_manager, long long int ignore) {
+    /* After one full circle every reference bit has been cleared, so two circles always find a victim */
+    for (long long int i=0; i<=2 * memory_manager->total_frame; i++) {
+        long long int frame_number = advance_clock_hand(memory_manager);
+        page_table_node_t* owner = memory_manager->frame_owners[frame_number].page_table;
+        if (!owner || owner->pid == ignore) {
+            continue;
+        }
+        /* Give referenced frames a second chance */
+        if (take_frame_reference(memory_manager, frame_number)) {
+            continue;
+        }
+        return frame_number;
+    }
+    assert(0);
+    return -1;
+}
 
-        to_print[index++] = evict_one_page(memory_manager, victim);
-        allocate_all_free_memory(memory_manager, process);
+/**
+ * returns a frame number to evict using the WSClock algorithm.
+ * Like CLOCK, but a frame that has not been referenced is only evicted once it has been unused for longer
+ * than the working set window. If a full circle finds none, the frame unused for longest is evicted.
+ * @param memory_manager
+ * @param ignore
+ * @return
+ */
+long long int WSCLOCK(virtual_memory_t* memory_manager, long long int ignore) {
+    long long int oldest = -1;
+    for (long long int i=0; i<memory_manager->total_frame; i++) {
+        long long int frame_number = advance_clock_hand(memory_manager);
+        page_table_node_t* owner = memory_manager->frame_owners[frame_number].page_table;
+        if (!owner || owner->pid == ignore) {
+            continue;
+        }
+        /* Referenced frames are in the working set, note when they were last seen in use */
+        if (take_frame_reference(memory_manager, frame_number)) {
+            memory_manager->last_used[frame_number] = memory_manager->now;
+            continue;
+        }
+        if (memory_manager->now - memory_manager->last_used[frame_number] > WSCLOCK_WINDOW) {
+            return frame_number;
+        }
+        if (oldest < 0 || memory_manager->last_used[frame_number] < memory_manager->last_used[oldest]) {
+            oldest = frame_number;
+        }
     }
-    if (evict_page_count > 0) {
-        printf("%lld, EVICTED, mem-addresses=", clock);
-        print_memory(to_print, evict_page_count);
-        printf("\n");
+    if (oldest < 0) {
+        /* Every candidate was referenced, and has now had its bit cleared */
+        return CLOCK(memory_manager, ignore);
     }
-    free(to_print);
+    /* Leave the hand just after the victim, as if the sweep had stopped there */
+    memory_manager->clock_hand = (oldest + 1) % memory_manager->total_frame;
+    return oldest;
 }
 
 /**
- * Allocate memory to a process. Evicting pages using LFU if memory is not sufficient.
+ * Allocate memory to a process, evicting pages chosen by a replacement policy if memory is not sufficient.
  * @param memory_manager
  * @param process
  * @param clock
+ * @param select_victim returns a frame to evict, which must not belong to the given pid
  */
-void virtual_memory_allocate_memory_LFU(virtual_memory_t* memory_manager, process_t* process, long long int clock) {
+static void allocate_memory(virtual_memory_t* memory_manager, process_t* process, long long int clock,
+                            long long int (*select_victim)(virtual_memory_t*, long long int)) {
     /* convert bytes to page counts */
     long long int page_required = byteToRequiredPage(process->memory, memory_manager->page_size);
     long long int allocation_target = page_required>MIN_PAGE_REQUIRED_TO_RUN?MIN_PAGE_REQUIRED_TO_RUN: page_required;
 
+    memory_manager->now = clock;
     page_table_node_t* allocated = get_page_table(memory_manager, process->pid);
 
     /* Create a page table for the process if not exist */
     if (!allocated) {
-        allocated = create_page_table_node(process->pid, page_required);
-        dlist_add_end(memory_manager->page_tables, allocated);
+        allocated = add_page_table(memory_manager, process->pid, page_required);
     }
     allocate_all_free_memory(memory_manager, process);
 
     /* The number of pages must be evicted to let the process run */
     long long int evict_page_count = allocation_target - allocated->valid_page_count;
     if (evict_page_count > 0) {
-        long long* to_print = malloc(sizeof(*to_print) * evict_page_count);
+        long long* to_print = pool_alloc(sizeof(*to_print) * evict_page_count);
         long long int index = 0;
 
         /* Evict pages if memory allocated isn't enough for execution */
         while (allocated->valid_page_count < allocation_target){
-            long long int victim = LFU(memory_manager, allocated->pid);
+            long long int victim = select_victim(memory_manager, allocated->pid);
 
             to_print[index++] = evict_one_page(memory_manager, victim);
             allocate_all_free_memory(memory_manager, process);
         }
-        if (evict_page_count > 0) {
-            printf("%lld, EVICTED, mem-addresses=", clock);
-            print_memory(to_print, evict_page_count);
-            printf("\n");
-        }
-        free(to_print);
+        printf("%lld, EVICTED, mem-addresses=", clock);
+        print_memory(to_print, evict_page_count);
+        printf("\n");
+        pool_free(to_print, sizeof(*to_print) * evict_page_count);
     }
+}
+
+/**
+ * Allocate memory to a process. Evicting pages using LRU if memory is not sufficient.
+ * @param memory_manager
+ * @param process
+ * @param clock
+ */
+void virtual_memory_allocate_memory_LRU(virtual_memory_t* memory_manager, process_t* process, long long int clock) {
+    allocate_memory(memory_manager, process, clock, LRU);
+}
+
+/**
+ * Allocate memory to a process. Evicting pages using LFU if memory is not sufficient.
+ * @param memory_manager
+ * @param process
+ * @param clock
+ */
+void virtual_memory_allocate_memory_LFU(virtual_memory_t* memory_manager, process_t* process, long long int clock) {
+    allocate_memory(memory_manager, process, clock, LFU);
+}
+
+/**
+ * Allocate memory to a process. Evicting pages using CLOCK if memory is not sufficient.
+ * @param memory_manager
+ * @param process
+ * @param clock
+ */
+void virtual_memory_allocate_memory_CLOCK(virtual_memory_t* memory_manager, process_t* process, long long int clock) {
+    allocate_memory(memory_manager, process, clock, CLOCK);
+}
+
+/**
+ * Allocate memory to a process. Evicting pages using WSClock if memory is not sufficient.
+ * @param memory_manager
+ * @param process
+ * @param clock
+ */
+void virtual_memory_allocate_memory_WSCLOCK(virtual_memory_t* memory_manager, process_t* process, long long int clock) {
+    allocate_memory(memory_manager, process, clock, WSCLOCK);
+}
+
+/**
+ * Allocate memory to a process. Evicting pages using ARC if memory is not sufficient.
+ * @param memory_manager
+ * @param process
+ * @param clock
+ */
+void virtual_memory_allocate_memory_ARC(virtual_memory_t* memory_manager, process_t* process, long long int clock) {
+    allocate_memory(memory_manager, process, clock, ARC);
+}
+
+/**
+ * Allocate memory to a process. Evicting pages using OPT if memory is not sufficient.
+ * @param memory_manager
+ * @param process
+ * @param clock
+ */
+void virtual_memory_allocate_memory_OPT(virtual_memory_t* memory_manager, process_t* process, long long int clock) {
+    allocate_memory(memory_manager, process, clock, OPT);
+}
+
+/**
+ * Allocate memory to a process. Evicting pages using the multi-generational LRU if memory is not sufficient.
+ * @param memory_manager
+ * @param process
+ * @param clock
+ */
+void virtual_memory_allocate_memory_MGLRU(virtual_memory_t* memory_manager, process_t* process, long long int clock) {
+    generation_index_advance(memory_manager->generations, clock);
+    allocate_memory(memory_manager, process, clock, MGLRU);
+}
 
+/**
+ * Allocate memory to a process. Evicting the least recently used pages if memory is not sufficient.
+ * @param memory_manager
+ * @param process
+ * @param clock
+ */
+void virtual_memory_allocate_memory_page_LRU(virtual_memory_t* memory_manager, process_t* process, long long int clock) {
+    allocate_memory(memory_manager, process, clock, page_LRU);
 }
+
 /*
- * Returns the pid of the least recently executed process in memory
+ * Returns the pid of the least recently executed process in memory.
+ * Page tables are dropped when their process finishes, so only live processes are walked.
  * @param memory_manager
+ * @param skip pid whose pages must not be chosen
  * @return
  */
 long long int find_the_oldest_process(virtual_memory_t* memory_manager, long long int skip) {
     assert(memory_manager);
-    long long int max_time = INT_MAX;
+    long long int max_time = LLONG_MAX;
     page_table_node_t* page_table_to_return = NULL;
     Node* current = memory_manager->page_tables->head;
 
@@ -322,13 +704,11 @@ long long int find_the_oldest_process(virtual_memory_t* memory_manager, long lon
  * @return
  */
 long long int first_page(virtual_memory_t* memory_manager, long long int pid) {
-    for (long long int i=0; i<memory_manager->total_frame; i++) {
-        // Find a page that's mapped into a page frame
-        if (memory_manager->page_frames[i] == pid) {
-            return i;
-        }
+    page_table_node_t* page_table = get_page_table(memory_manager, pid);
+    if (!page_table || page_table->valid_page_count == 0) {
+        return -1;
     }
-    return -1;
+    return page_table->resident_frames[0];
 }
 
 /**
@@ -338,17 +718,35 @@ long long int first_page(virtual_memory_t* memory_manager, long long int pid) {
  * @param frame_number
  */
 void unmap(virtual_memory_t* memory_manager, page_table_node_t* page_table, long long int frame_number) {
-    for (long long int i=0; i<page_table->page_count; i++) {
-        if (page_table->page_table_pointer[i].validity == 1 && page_table->page_table_pointer[i].frame_number == frame_number) {
-            // Set page frame to -1, indicating not occupied
-            memory_manager->page_frames[frame_number] = NOT_OCCUPIED;
-            memory_manager->counter[frame_number] = 0;
-            page_table->page_table_pointer[i].validity = 0;
-            page_table->page_table_pointer[i].frame_number = -1;
-            page_table->valid_page_count -= 1;
-            memory_manager->free_frame += 1;
-        }
+    frame_owner_t* owner = &memory_manager->frame_owners[frame_number];
+    assert(owner->page_table == page_table);
+    long long int i = owner->page;
+    assert(page_table->page_table_pointer[i].validity == 1 && page_table->page_table_pointer[i].frame_number == frame_number);
+    // Set page frame to -1, indicating not occupied
+    memory_manager->page_frames[frame_number] = NOT_OCCUPIED;
+    frame_bitmap_set(memory_manager->free_frames, frame_number);
+    reset_counter(memory_manager, frame_number);
+    untrack_counter(memory_manager, frame_number);
+    owner->page_table = NULL;
+    owner->page = -1;
+    page_table->page_table_pointer[i].reference = take_frame_reference(memory_manager, frame_number);
+    if (memory_manager->arc) {
+        arc_index_evict(memory_manager->arc, frame_number, &page_table->page_table_pointer[i].ghost);
+    }
+    if (memory_manager->generations) {
+        generation_index_remove(memory_manager->generations, frame_number);
+    }
+    if (memory_manager->recency) {
+        lru_list_remove(memory_manager->recency, frame_number);
     }
+    page_table->page_table_pointer[i].validity = 0;
+    page_table->page_table_pointer[i].frame_number = -1;
+    remove_resident_frame(page_table, frame_number);
+    page_table->valid_page_count -= 1;
+    if (memory_manager->furthest && page_table->valid_page_count == 0) {
+        furthest_heap_remove(memory_manager->furthest, page_table);
+    }
+    memory_manager->free_frame += 1;
 }
 /**
  * Evicts the given frame from memory
@@ -357,18 +755,26 @@ void unmap(virtual_memory_t* memory_manager, page_table_node_t* page_table, long
  * @return
  */
 long long int evict_one_page(virtual_memory_t* memory_manager, long long int frame_number) {
-    page_table_node_t* page_table = get_page_table(memory_manager, memory_manager->page_frames[frame_number]);
+    /* The owner of a frame is known without looking up its pid */
+    page_table_node_t* page_table = memory_manager->frame_owners[frame_number].page_table;
+    assert(page_table);
     unmap(memory_manager, page_table, frame_number);
     return frame_number;
 }
 
 /**
- * Print page frames for debugging purpose
+ * Set the reference bits of every page of a process to 1.
+ * Resident pages keep theirs in the frame bitmap, the rest in the page table.
  * @param memory_manager
+ * @param page_table
  */
-void print_page_frames(virtual_memory_t* memory_manager) {
-    for (long long int i=0; i<memory_manager->total_frame; i++) {
-        printf("%llu %lld %d\n", i, memory_manager->page_frames[i], memory_manager->counter[i]);
+static void reference_pages(virtual_memory_t* memory_manager, page_table_node_t* page_table) {
+    for (long long int i=0; i<page_table->page_count; i++) {
+        if (page_table->page_table_pointer[i].validity) {
+            reference_frame(memory_manager, page_table->page_table_pointer[i].frame_number);
+        } else {
+            page_table->page_table_pointer[i].reference = 1;
+        }
     }
 }
 
@@ -382,16 +788,199 @@ void print_page_frames(virtual_memory_t* memory_manager) {
 void virtual_use_memory(virtual_memory_t* memory_manager, process_t* process, long long int clock) {
     page_table_node_t* page_table = get_page_table(memory_manager, process->pid);
     page_table->last_access = clock;
-    /*
-     * Set the reference bits to 1
-     */
-    for (long long int i=0; i<page_table->page_count; i++) {
-        page_table->page_table_pointer[i].reference = 1;
-    }
+    reference_pages(memory_manager, page_table);
     aging(memory_manager);
 
 }
 
+/**
+ * Simulate the use of memory for the clock policies.
+ * Reference bits are left set for the clock hand rather than aged.
+ * @param memory_manager
+ * @param process
+ * @param clock
+ */
+void virtual_use_memory_clock(virtual_memory_t* memory_manager, process_t* process, long long int clock) {
+    page_table_node_t* page_table = get_page_table(memory_manager, process->pid);
+    page_table->last_access = clock;
+    memory_manager->now = clock;
+    reference_pages(memory_manager, page_table);
+}
+
+/**
+ * Simulate the use of memory over a number of ticks for the clock policies.
+ * Setting a reference bit again has no effect, so this is the same as the last tick.
+ * @param memory_manager
+ * @param process
+ * @param clock
+ * @param ticks
+ */
+void virtual_use_memory_ticks_clock(virtual_memory_t* memory_manager, process_t* process, long long int clock, long long int ticks) {
+    virtual_use_memory_clock(memory_manager, process, clock + ticks - 1);
+}
+
+/**
+ * Reference the resident pages of a process from tick start to tick end for ARC.
+ * A process using memory on consecutive ticks is one access to its pages, so a page only counts as
+ * referenced again in a later run of its process than the one it was loaded for.
+ * @param memory_manager
+ * @param page_table
+ * @param start
+ * @param end
+ */
+static void reference_run(virtual_memory_t* memory_manager, page_table_node_t* page_table, long long int start, long long int end) {
+    bool new_run = page_table->last_access < start - 1;
+    for (long long int i=0; i<page_table->valid_page_count; i++) {
+        long long int frame_number = page_table->resident_frames[i];
+        /* last_used holds the tick the page was loaded */
+        bool again = new_run && memory_manager->last_used[frame_number] <= page_table->last_access;
+        arc_index_reference(memory_manager->arc, frame_number, again);
+    }
+    page_table->last_access = end;
+    memory_manager->now = end;
+}
+
+/**
+ * Simulate the use of memory for ARC
+ * @param memory_manager
+ * @param process
+ * @param clock
+ */
+void virtual_use_memory_arc(virtual_memory_t* memory_manager, process_t* process, long long int clock) {
+    reference_run(memory_manager, get_page_table(memory_manager, process->pid), clock, clock);
+}
+
+/**
+ * Simulate the use of memory over a number of ticks for ARC.
+ * Referencing the same pages again leaves them in the same order, so the ticks are one reference.
+ * @param memory_manager
+ * @param process
+ * @param clock
+ * @param ticks
+ */
+void virtual_use_memory_ticks_arc(virtual_memory_t* memory_manager, process_t* process, long long int clock, long long int ticks) {
+    reference_run(memory_manager, get_page_table(memory_manager, process->pid), clock, clock + ticks - 1);
+}
+
+/**
+ * Use the memory of a process from tick start to tick end for OPT, moving on to its next run
+ * @param memory_manager
+ * @param page_table
+ * @param start
+ * @param end
+ */
+static void schedule_run(virtual_memory_t* memory_manager, page_table_node_t* page_table, long long int start, long long int end) {
+    next_use_observe(memory_manager->schedule, page_table->pid, start, end);
+    page_table->last_access = end;
+    page_table->next_use = next_use_of(memory_manager->schedule, page_table->pid);
+    if (page_table->furthest_index >= 0) {
+        furthest_heap_update(memory_manager->furthest, page_table);
+    }
+}
+
+/**
+ * Simulate the use of memory for OPT
+ * @param memory_manager
+ * @param process
+ * @param clock
+ */
+void virtual_use_memory_opt(virtual_memory_t* memory_manager, process_t* process, long long int clock) {
+    schedule_run(memory_manager, get_page_table(memory_manager, process->pid), clock, clock);
+}
+
+/**
+ * Simulate the use of memory over a number of ticks for OPT
+ * @param memory_manager
+ * @param process
+ * @param clock
+ * @param ticks
+ */
+void virtual_use_memory_ticks_opt(virtual_memory_t* memory_manager, process_t* process, long long int clock, long long int ticks) {
+    schedule_run(memory_manager, get_page_table(memory_manager, process->pid), clock, clock + ticks - 1);
+}
+
+/**
+ * Simulate the use of memory for the multi-generational LRU.
+ * Generations are aged by time rather than by sweeping counters, and the pages of the process are
+ * stamped with the youngest generation.
+ * @param memory_manager
+ * @param process
+ * @param clock
+ */
+void virtual_use_memory_mglru(virtual_memory_t* memory_manager, process_t* process, long long int clock) {
+    page_table_node_t* page_table = get_page_table(memory_manager, process->pid);
+    page_table->last_access = clock;
+    memory_manager->now = clock;
+    generation_index_advance(memory_manager->generations, clock);
+    for (long long int i=0; i<page_table->valid_page_count; i++) {
+        generation_index_reference(memory_manager->generations, page_table->resident_frames[i]);
+    }
+}
+
+/**
+ * Simulate the use of memory over a number of ticks for the multi-generational LRU.
+ * References do not move frames, so after aging through the ticks the last tick leaves the same state.
+ * @param memory_manager
+ * @param process
+ * @param clock
+ * @param ticks
+ */
+void virtual_use_memory_ticks_mglru(virtual_memory_t* memory_manager, process_t* process, long long int clock, long long int ticks) {
+    virtual_use_memory_mglru(memory_manager, process, clock + ticks - 1);
+}
+
+/**
+ * Simulate the use of memory for per page LRU.
+ * Each tick the process references one resident page, sweeping through its resident pages in order,
+ * and only that page becomes the most recently used.
+ * @param memory_manager
+ * @param process
+ * @param clock
+ */
+void virtual_use_memory_page_lru(virtual_memory_t* memory_manager, process_t* process, long long int clock) {
+    virtual_use_memory_ticks_page_lru(memory_manager, process, clock, 1);
+}
+
+/**
+ * Simulate the use of memory over a number of ticks for per page LRU.
+ * A page referenced again later in the sweep only keeps its last reference, so at most one sweep is applied.
+ * @param memory_manager
+ * @param process
+ * @param clock
+ * @param ticks
+ */
+void virtual_use_memory_ticks_page_lru(virtual_memory_t* memory_manager, process_t* process, long long int clock, long long int ticks) {
+    page_table_node_t* page_table = get_page_table(memory_manager, process->pid);
+    page_table->last_access = clock + ticks - 1;
+    memory_manager->now = clock + ticks - 1;
+    long long int resident = page_table->valid_page_count;
+    if (resident > 0) {
+        long long int skipped = ticks > resident ? ticks - resident : 0;
+        for (long long int i=skipped; i<ticks; i++) {
+            long long int reference = (page_table->references + i) % resident;
+            lru_list_touch(memory_manager->recency, page_table->resident_frames[reference]);
+        }
+    }
+    page_table->references += ticks;
+}
+
+/**
+ * Simulate the use of memory over a number of ticks starting from clock.
+ * Equivalent to calling virtual_use_memory once per tick.
+ * @param memory_manager
+ * @param process
+ * @param clock
+ * @param ticks
+ */
+void virtual_use_memory_ticks(virtual_memory_t* memory_manager, process_t* process, long long int clock, long long int ticks) {
+    page_table_node_t* page_table = get_page_table(memory_manager, process->pid);
+    virtual_use_memory(memory_manager, process, clock);
+    if (ticks > 1) {
+        page_table->last_access = clock + ticks - 1;
+        aging_ticks(memory_manager, page_table, ticks - 1);
+    }
+}
+
 /**
  * Print status of a process and its memory usage
  * @param memory_manager
@@ -427,32 +1016,51 @@ long long int virtual_memory_usage(virtual_memory_t* memory_manager) {
 long long int virtual_memory_free_memory(virtual_memory_t* memory_manager, process_t* process, long long int clock) {
     page_table_node_t* page_table= get_page_table(memory_manager, process->pid);
     assert(page_table);
-    long long int page_to_free = page_table->valid_page_count;
-    long long int* to_print = malloc(sizeof(*to_print) * page_to_free);
-    long long int index = 0;
-
-    long long int free_counter = 0;
-    for (long long int i=0; i<page_table->page_count; i++) {
-        // Find a page that's mapped into a page frame
-        if (page_table->page_table_pointer[i].validity == 1 && page_table->page_table_pointer[i].frame_number != NOT_OCCUPIED) {
-            // Set page frame to -1, indicating not occupied
-            to_print[index++] = page_table->page_table_pointer[i].frame_number;
-            memory_manager->page_frames[page_table->page_table_pointer[i].frame_number] = NOT_OCCUPIED;
-            memory_manager->counter[page_table->page_table_pointer[i].frame_number] = 0;
-            page_table->page_table_pointer[i].frame_number = -1;
-            page_table->page_table_pointer[i].validity = 0;
-            page_table->valid_page_count -= 1;
-            memory_manager->free_frame += 1;
-            free_counter++;
+    long long int free_counter = page_table->valid_page_count;
+    /* Resident frames are in order, so they are released and printed without sorting */
+    for (long long int i=0; i<free_counter; i++) {
+        long long int frame_number = page_table->resident_frames[i];
+        long long int page = memory_manager->frame_owners[frame_number].page;
+        // Set page frame to -1, indicating not occupied
+        memory_manager->page_frames[frame_number] = NOT_OCCUPIED;
+        frame_bitmap_set(memory_manager->free_frames, frame_number);
+        memory_manager->frame_owners[frame_number].page_table = NULL;
+        memory_manager->frame_owners[frame_number].page = -1;
+        reset_counter(memory_manager, frame_number);
+        untrack_counter(memory_manager, frame_number);
+        page_table->page_table_pointer[page].reference = take_frame_reference(memory_manager, frame_number);
+        page_table->page_table_pointer[page].frame_number = -1;
+        page_table->page_table_pointer[page].validity = 0;
+        if (memory_manager->arc) {
+            arc_index_remove(memory_manager->arc, frame_number);
+        }
+        if (memory_manager->generations) {
+            generation_index_remove(memory_manager->generations, frame_number);
+        }
+        if (memory_manager->recency) {
+            lru_list_remove(memory_manager->recency, frame_number);
+        }
+        memory_manager->free_frame += 1;
+    }
+    page_table->valid_page_count = 0;
+    if (memory_manager->furthest && page_table->furthest_index >= 0) {
+        furthest_heap_remove(memory_manager->furthest, page_table);
+    }
+    /* The process is finished, so its evicted pages will not come back */
+    if (memory_manager->arc) {
+        for (long long int i=0; i<page_table->page_count; i++) {
+            arc_index_forget(memory_manager->arc, &page_table->page_table_pointer[i].ghost);
         }
     }
     printf("%lld, EVICTED, mem-addresses=", clock);
-    print_memory(to_print, page_to_free);
+    print_sorted_memory(page_table->resident_frames, free_counter);
     printf("\n");
-    free(to_print);
     fprintf(stderr, "<Memory> Deallocate %lld virtual pages of process %lld\n",
               free_counter,
               page_table->pid);
+    /* The page table of a finished process is dropped, so only live processes are kept and searched */
+    pid_map_remove(memory_manager->page_table_index, page_table->pid);
+    dlist_remove(memory_manager->page_tables, &page_table->node);
     return free_counter;
 }
 
@@ -464,18 +1072,9 @@ long long int virtual_memory_free_memory(virtual_memory_t* memory_manager, proce
 void virtual_print_addresses(virtual_memory_t* memory_manager, process_t* process) {
     page_table_node_t* page_table = get_page_table(memory_manager, process->pid);
     assert(page_table);
-    long long int* addr_to_print = malloc(sizeof(*addr_to_print) * page_table->valid_page_count);
-    long long int index = 0;
-    for (long long int i=0; i<memory_manager->total_frame; i++) {
-        if (memory_manager->page_frames[i] == process->pid) {
-            addr_to_print[index] = i;
-            index++;
-        }
-    }
     printf("mem-addresses=");
-    print_memory(addr_to_print, page_table->valid_page_count);
+    print_sorted_memory(page_table->resident_frames, page_table->valid_page_count);
     printf("\n");
-    free(addr_to_print);
 }
 
 /**
@@ -549,6 +1148,8 @@ memory_allocator_t* create_virtual_memory_allocator_LRU(long long int memory_siz
     allocator->info = (void (*)(void *, process_t *, long long int)) virtual_process_info;
     allocator->free = (void (*)(void *, process_t *, long long int)) virtual_memory_free_memory;
     allocator->load = (void (*)(void *, process_t *)) virtual_memory_load_process;
+    allocator->use_ticks = (void (*)(void *, process_t *, long long int, long long int)) virtual_use_memory_ticks;
+    allocator->load_ticks = (void (*)(void *, process_t *, long long int)) virtual_memory_load_process_ticks;
     allocator->load_time_left = (long long int (*)(void *, process_t *)) virtual_load_time_left;
     allocator->require_allocation = (long long int (*)(void *, process_t *)) (long long int (*)(void *,
                                                                              process_t *)) virtual_require_allocation;
@@ -572,37 +1173,210 @@ memory_allocator_t* create_virtual_memory_allocator_LFU(long long int memory_siz
     allocator->info = (void (*)(void *, process_t *, long long int)) virtual_process_info;
     allocator->free = (void (*)(void *, process_t *, long long int)) virtual_memory_free_memory;
     allocator->load = (void (*)(void *, process_t *)) virtual_memory_load_process;
+    allocator->use_ticks = (void (*)(void *, process_t *, long long int, long long int)) virtual_use_memory_ticks;
+    allocator->load_ticks = (void (*)(void *, process_t *, long long int)) virtual_memory_load_process_ticks;
     allocator->load_time_left = (long long int (*)(void *, process_t *)) virtual_load_time_left;
     allocator->require_allocation = (long long int (*)(void *, process_t *)) (long long int (*)(void *,
                                                                             process_t *)) virtual_require_allocation;
     allocator->page_fault = (long long int (*)(void *, process_t *)) virtual_page_fault;
     // Unlimited allocator doesn't have a structure to manage memory;
-    allocator->structure = create_virtual_memory(memory_size, page_size);
+    virtual_memory_t* memory_manager = create_virtual_memory(memory_size, page_size);
+    memory_manager->frequencies = create_lfu_index(memory_manager->total_frame);
+    allocator->structure = memory_manager;
+    return allocator;
+}
+
+/**
+ * Create a virtual memory allocator that leaves reference bits to a clock policy
+ * @param memory_size
+ * @param page_size
+ * @param malloc_function
+ * @return
+ */
+static memory_allocator_t* create_clock_allocator(long long int memory_size, long long int page_size,
+                                                  void (*malloc_function)(virtual_memory_t*, process_t*, long long int)) {
+    memory_allocator_t* allocator = malloc(sizeof(*allocator));
+    assert(allocator);
+    allocator->malloc = (void *(*)(void *, process_t *, long long int)) malloc_function;
+    allocator->use = (void (*)(void *, process_t *, long long int)) virtual_use_memory_clock;
+    allocator->info = (void (*)(void *, process_t *, long long int)) virtual_process_info;
+    allocator->free = (void (*)(void *, process_t *, long long int)) virtual_memory_free_memory;
+    allocator->load = (void (*)(void *, process_t *)) virtual_memory_load_process;
+    allocator->use_ticks = (void (*)(void *, process_t *, long long int, long long int)) virtual_use_memory_ticks_clock;
+    allocator->load_ticks = (void (*)(void *, process_t *, long long int)) virtual_memory_load_process_ticks;
+    allocator->load_time_left = (long long int (*)(void *, process_t *)) virtual_load_time_left;
+    allocator->require_allocation = (long long int (*)(void *, process_t *)) virtual_require_allocation;
+    allocator->page_fault = (long long int (*)(void *, process_t *)) virtual_page_fault;
+    virtual_memory_t* memory_manager = create_virtual_memory(memory_size, page_size);
+    memory_manager->ages_counters = false;
+    allocator->structure = memory_manager;
+    return allocator;
+}
+
+/**
+ * Create an implementation of memory allocator for virtual memory using CLOCK
+ * @param memory_size
+ * @param page_size
+ * @return
+ */
+memory_allocator_t* create_virtual_memory_allocator_CLOCK(long long int memory_size, long long int page_size) {
+    return create_clock_allocator(memory_size, page_size, virtual_memory_allocate_memory_CLOCK);
+}
+
+/**
+ * Create an implementation of memory allocator for virtual memory using WSClock
+ * @param memory_size
+ * @param page_size
+ * @return
+ */
+memory_allocator_t* create_virtual_memory_allocator_WSCLOCK(long long int memory_size, long long int page_size) {
+    return create_clock_allocator(memory_size, page_size, virtual_memory_allocate_memory_WSCLOCK);
+}
+
+/**
+ * Create an implementation of memory allocator for virtual memory using ARC
+ * @param memory_size
+ * @param page_size
+ * @return
+ */
+memory_allocator_t* create_virtual_memory_allocator_ARC(long long int memory_size, long long int page_size) {
+    memory_allocator_t* allocator = malloc(sizeof(*allocator));
+    assert(allocator);
+    allocator->malloc = (void *(*)(void *, process_t *, long long int)) virtual_memory_allocate_memory_ARC;
+    allocator->use = (void (*)(void *, process_t *, long long int)) virtual_use_memory_arc;
+    allocator->info = (void (*)(void *, process_t *, long long int)) virtual_process_info;
+    allocator->free = (void (*)(void *, process_t *, long long int)) virtual_memory_free_memory;
+    allocator->load = (void (*)(void *, process_t *)) virtual_memory_load_process;
+    allocator->use_ticks = (void (*)(void *, process_t *, long long int, long long int)) virtual_use_memory_ticks_arc;
+    allocator->load_ticks = (void (*)(void *, process_t *, long long int)) virtual_memory_load_process_ticks;
+    allocator->load_time_left = (long long int (*)(void *, process_t *)) virtual_load_time_left;
+    allocator->require_allocation = (long long int (*)(void *, process_t *)) virtual_require_allocation;
+    allocator->page_fault = (long long int (*)(void *, process_t *)) virtual_page_fault;
+    virtual_memory_t* memory_manager = create_virtual_memory(memory_size, page_size);
+    memory_manager->ages_counters = false;
+    memory_manager->arc = create_arc_index(memory_manager->total_frame);
+    allocator->structure = memory_manager;
+    return allocator;
+}
+
+/**
+ * Create an implementation of memory allocator for virtual memory using Belady's optimal algorithm
+ * @param memory_size
+ * @param page_size
+ * @param schedule runs of every process, or an empty schedule to record them in
+ * @return
+ */
+memory_allocator_t* create_virtual_memory_allocator_OPT(long long int memory_size, long long int page_size, next_use_t* schedule) {
+    memory_allocator_t* allocator = malloc(sizeof(*allocator));
+    assert(allocator);
+    allocator->malloc = (void *(*)(void *, process_t *, long long int)) virtual_memory_allocate_memory_OPT;
+    allocator->use = (void (*)(void *, process_t *, long long int)) virtual_use_memory_opt;
+    allocator->info = (void (*)(void *, process_t *, long long int)) virtual_process_info;
+    allocator->free = (void (*)(void *, process_t *, long long int)) virtual_memory_free_memory;
+    allocator->load = (void (*)(void *, process_t *)) virtual_memory_load_process;
+    allocator->use_ticks = (void (*)(void *, process_t *, long long int, long long int)) virtual_use_memory_ticks_opt;
+    allocator->load_ticks = (void (*)(void *, process_t *, long long int)) virtual_memory_load_process_ticks;
+    allocator->load_time_left = (long long int (*)(void *, process_t *)) virtual_load_time_left;
+    allocator->require_allocation = (long long int (*)(void *, process_t *)) virtual_require_allocation;
+    allocator->page_fault = (long long int (*)(void *, process_t *)) virtual_page_fault;
+    virtual_memory_t* memory_manager = create_virtual_memory(memory_size, page_size);
+    memory_manager->ages_counters = false;
+    memory_manager->schedule = schedule;
+    memory_manager->furthest = create_furthest_heap();
+    allocator->structure = memory_manager;
+    return allocator;
+}
+
+/**
+ * Create an implementation of memory allocator for virtual memory using the multi-generational LRU
+ * @param memory_size
+ * @param page_size
+ * @return
+ */
+memory_allocator_t* create_virtual_memory_allocator_MGLRU(long long int memory_size, long long int page_size) {
+    memory_allocator_t* allocator = malloc(sizeof(*allocator));
+    assert(allocator);
+    allocator->malloc = (void *(*)(void *, process_t *, long long int)) virtual_memory_allocate_memory_MGLRU;
+    allocator->use = (void (*)(void *, process_t *, long long int)) virtual_use_memory_mglru;
+    allocator->info = (void (*)(void *, process_t *, long long int)) virtual_process_info;
+    allocator->free = (void (*)(void *, process_t *, long long int)) virtual_memory_free_memory;
+    allocator->load = (void (*)(void *, process_t *)) virtual_memory_load_process;
+    allocator->use_ticks = (void (*)(void *, process_t *, long long int, long long int)) virtual_use_memory_ticks_mglru;
+    allocator->load_ticks = (void (*)(void *, process_t *, long long int)) virtual_memory_load_process_ticks;
+    allocator->load_time_left = (long long int (*)(void *, process_t *)) virtual_load_time_left;
+    allocator->require_allocation = (long long int (*)(void *, process_t *)) virtual_require_allocation;
+    allocator->page_fault = (long long int (*)(void *, process_t *)) virtual_page_fault;
+    virtual_memory_t* memory_manager = create_virtual_memory(memory_size, page_size);
+    memory_manager->ages_counters = false;
+    memory_manager->generations = create_generation_index(memory_manager->total_frame);
+    allocator->structure = memory_manager;
+    return allocator;
+}
+
+/**
+ * Create an implementation of memory allocator for virtual memory using LRU over pages
+ * @param memory_size
+ * @param page_size
+ * @return
+ */
+memory_allocator_t* create_virtual_memory_allocator_page_LRU(long long int memory_size, long long int page_size) {
+    memory_allocator_t* allocator = malloc(sizeof(*allocator));
+    assert(allocator);
+    allocator->malloc = (void *(*)(void *, process_t *, long long int)) virtual_memory_allocate_memory_page_LRU;
+    allocator->use = (void (*)(void *, process_t *, long long int)) virtual_use_memory_page_lru;
+    allocator->info = (void (*)(void *, process_t *, long long int)) virtual_process_info;
+    allocator->free = (void (*)(void *, process_t *, long long int)) virtual_memory_free_memory;
+    allocator->load = (void (*)(void *, process_t *)) virtual_memory_load_process;
+    allocator->use_ticks = (void (*)(void *, process_t *, long long int, long long int)) virtual_use_memory_ticks_page_lru;
+    allocator->load_ticks = (void (*)(void *, process_t *, long long int)) virtual_memory_load_process_ticks;
+    allocator->load_time_left = (long long int (*)(void *, process_t *)) virtual_load_time_left;
+    allocator->require_allocation = (long long int (*)(void *, process_t *)) virtual_require_allocation;
+    allocator->page_fault = (long long int (*)(void *, process_t *)) virtual_page_fault;
+    virtual_memory_t* memory_manager = create_virtual_memory(memory_size, page_size);
+    memory_manager->ages_counters = false;
+    memory_manager->recency = create_lru_list(memory_manager->total_frame);
+    allocator->structure = memory_manager;
     return allocator;
 }
 
 /**
  * Reduces the frequency of pages according to its usage.
+ * Only frames whose bit is set in the reference bitmap are visited. Every other counter owes its shifts
+ * until it is read, so there is no sweep over all counters left to run in bulk.
  * @param memory_manager
  */
 void aging(virtual_memory_t* memory_manager) {
-
-    Node* curr = memory_manager->page_tables->head;
-    while (curr) {
-        page_table_node_t* page_table = (page_table_node_t*)curr->data;
-        assert(page_table);
-        for (long long int i=0; i<page_table->page_count; i++) {
-            if (page_table->page_table_pointer[i].validity) {
-                long long int frame_number = page_table->page_table_pointer[i].frame_number;
-                /* shift the counter 1 bit right */
-                memory_manager->counter[frame_number] >>= 0x1;
-                /* and put 1 if the R bit is 1 */
-                if (page_table->page_table_pointer[i].reference == 1) {
-                    memory_manager->counter[frame_number] |= 0x1 << 7;
-                    page_table->page_table_pointer[i].reference = 0;
-                }
-            }
+    /* Every counter owes one more shift, applied when it is next read.
+     * Frames with the R bit set are brought up to date now so that 1 can be put in */
+    advance_epoch(memory_manager, 1);
+    for (long long int i=0; i<memory_manager->referenced_count; i++) {
+        long long int frame_number = memory_manager->referenced_frames[i];
+        if (take_frame_reference(memory_manager, frame_number)) {
+            memory_manager->counter[frame_number] = frame_counter(memory_manager, frame_number) | (0x1 << 7);
+            track_counter(memory_manager, frame_number);
         }
-        curr = curr->next;
+    }
+    memory_manager->referenced_count = 0;
+}
+
+/**
+ * Ages all pages by the given number of ticks, assuming only the running process references memory.
+ * Pages of the running process have their reference bit put in on every tick,
+ * while the counters of other pages are simply shifted.
+ * Reference bits must have been cleared by a previous call to aging.
+ * @param memory_manager
+ * @param running page table of the running process
+ * @param ticks
+ */
+void aging_ticks(virtual_memory_t* memory_manager, page_table_node_t* running, long long int ticks) {
+    /* Counters only use the lowest 8 bits, so every bit has been shifted out after 8 ticks */
+    long long int shift = ticks < MAX_AGING_SHIFT ? ticks : MAX_AGING_SHIFT;
+    unsigned int referenced = (0xFFu << (MAX_AGING_SHIFT - shift)) & 0xFFu;
+    /* Only pages of the running process are brought up to date, the rest owe the shifts */
+    advance_epoch(memory_manager, ticks);
+    for (long long int i=0; i<running->valid_page_count; i++) {
+        long long int frame_number = running->resident_frames[i];
+        memory_manager->counter[frame_number] = frame_counter(memory_manager, frame_number) | referenced;
+        track_counter(memory_manager, frame_number);
     }
 }
\ No newline at end of file
@@ -17,6 +17,14 @@
 #include "ctype.h"
 #include "constants.h"
 #include "scheduler.h"
+#include "pid_map.h"
+#include "frame_bitmap.h"
+#include "lfu_index.h"
+#include "arc_index.h"
+#include "next_use.h"
+#include "furthest_heap.h"
+#include "generation_index.h"
+#include "lru_list.h"
 #define NOT_OCCUPIED -1
 #define MIN_PAGE_REQUIRED_TO_RUN 4
 
@@ -26,15 +34,55 @@ typedef struct virtual_memory {
     long long int total_frame;
     /* This array records which process each page has been mapped into */
     long long int* page_frames;
-    /* This array records how many time each page has been referenced */
+    /* Free frames in page_frames, handed out lowest first */
+    frame_bitmap_t* free_frames;
+    /* This array records which page table entry each frame is mapped from */
+    struct frame_owner* frame_owners;
+    /* This array records how many time each page has been referenced, as of the epoch in aged_at */
     unsigned int* counter;
+    /* This array records the aging tick each counter was last brought up to date */
+    long long int* aged_at;
+    /* Number of aging ticks so far */
+    long long int epoch;
+    /* Reference bits of pages mapped into each frame, one bit per frame */
+    uint8_t* reference_bits;
+    /* Frames whose reference bit has been set since the last aging tick, may contain frames since cleared */
+    long long int* referenced_frames;
+    long long int referenced_count;
+    /* Frames indexed by counter for LFU, NULL when the LRU policy is used */
+    lfu_index_t* frequencies;
+    /* Whether counters are aged on every tick. The clock policies leave reference bits for the clock hand instead */
+    bool ages_counters;
+    /* Next frame the clock hand looks at */
+    long long int clock_hand;
+    /* This array records the last time each frame was seen referenced by the clock hand, or loaded */
+    long long int* last_used;
+    /* The time of the latest allocation or reference */
+    long long int now;
+    /* Frames and ghosts of the adaptive replacement cache, NULL unless the ARC policy is used */
+    arc_index_t* arc;
+    /* Runs of every process recorded ahead of time, and the page tables with resident pages by next run.
+     * NULL unless the OPT policy is used. The schedule is owned by whoever created the allocator */
+    next_use_t* schedule;
+    furthest_heap_t* furthest;
+    /* Frames by generation, NULL unless the multi-generational LRU policy is used */
+    generation_index_t* generations;
+    /* Frames by the time their page was last used, NULL unless the per page LRU policy is used */
+    lru_list_t* recency;
+    /* Number of page tables created so far */
+    long long int page_table_count;
+    /* Page tables in creation order, which decides ties between processes */
     Dlist* page_tables;
+    /* Maps pid to its page table in page_tables */
+    pid_map_t* page_table_index;
 } virtual_memory_t;
 
 typedef struct page_table_entry {
     long long int validity;
     long long int frame_number;
     long long int reference;
+    /* Slot of the ARC ghost remembering this page after it was evicted, -1 if none */
+    long long int ghost;
 } page_table_entry_t;
 
 
@@ -45,10 +93,30 @@ typedef struct page_table_node {
     long long int last_access;
     long long int valid_page_count;
     long long int loading_time_left;
+    /* Frames mapped by this process in increasing order, valid_page_count of them */
+    long long int* resident_frames;
+    long long int resident_capacity;
+    /* The run this process is next used in, for OPT */
+    long long int next_use;
+    /* Position in the furthest heap, -1 if not in it */
+    long long int furthest_index;
+    /* Order the page table was created in */
+    long long int created;
+    /* Ticks the process has run for, which picks the page it references next in per page LRU */
+    long long int references;
+    /* Links of the page table in page_tables, which is intrusive */
+    Node node;
 } page_table_node_t;
 
+typedef struct frame_owner {
+    /* NULL if the frame is not occupied */
+    page_table_node_t* page_table;
+    long long int page;
+} frame_owner_t;
+
 long long int evict_one_page(virtual_memory_t* memory_manager, long long int frame_number);
 page_table_node_t* create_page_table_node(long long int pid, long long int page_count);
+void free_page_table_node(page_table_node_t* page_table);
 virtual_memory_t* create_virtual_memory(long long int memory_size, long long int page_size);
 long long int find_the_oldest_process(virtual_memory_t* memory_manager, long long int skip);
 void virtual_memory_allocate_memory_LRU(virtual_memory_t* memory_manager, process_t* process, long long int clock);
@@ -57,10 +125,45 @@ void virtual_memory_allocate_memory_LFU(virtual_memory_t* memory_manager, proces
 long long int least_recent_used(virtual_memory_t* memory_manager, long long int skip);
 memory_allocator_t* create_virtual_memory_allocator_LFU(long long int memory_size, long long int page_size);
 memory_allocator_t* create_virtual_memory_allocator_LRU(long long int memory_size, long long int page_size);
+memory_allocator_t* create_virtual_memory_allocator_CLOCK(long long int memory_size, long long int page_size);
+memory_allocator_t* create_virtual_memory_allocator_WSCLOCK(long long int memory_size, long long int page_size);
+memory_allocator_t* create_virtual_memory_allocator_ARC(long long int memory_size, long long int page_size);
+memory_allocator_t* create_virtual_memory_allocator_OPT(long long int memory_size, long long int page_size, next_use_t* schedule);
+memory_allocator_t* create_virtual_memory_allocator_MGLRU(long long int memory_size, long long int page_size);
+memory_allocator_t* create_virtual_memory_allocator_page_LRU(long long int memory_size, long long int page_size);
+void virtual_memory_allocate_memory_page_LRU(virtual_memory_t* memory_manager, process_t* process, long long int clock);
+long long int page_LRU(virtual_memory_t* memory_manager, long long int ignore);
+void virtual_use_memory_page_lru(virtual_memory_t* memory_manager, process_t* process, long long int clock);
+void virtual_use_memory_ticks_page_lru(virtual_memory_t* memory_manager, process_t* process, long long int clock, long long int ticks);
+void virtual_memory_allocate_memory_MGLRU(virtual_memory_t* memory_manager, process_t* process, long long int clock);
+long long int MGLRU(virtual_memory_t* memory_manager, long long int ignore);
+void virtual_use_memory_mglru(virtual_memory_t* memory_manager, process_t* process, long long int clock);
+void virtual_use_memory_ticks_mglru(virtual_memory_t* memory_manager, process_t* process, long long int clock, long long int ticks);
+void virtual_memory_allocate_memory_OPT(virtual_memory_t* memory_manager, process_t* process, long long int clock);
+long long int OPT(virtual_memory_t* memory_manager, long long int ignore);
+void virtual_use_memory_opt(virtual_memory_t* memory_manager, process_t* process, long long int clock);
+void virtual_use_memory_ticks_opt(virtual_memory_t* memory_manager, process_t* process, long long int clock, long long int ticks);
+void virtual_memory_allocate_memory_ARC(virtual_memory_t* memory_manager, process_t* process, long long int clock);
+long long int ARC(virtual_memory_t* memory_manager, long long int ignore);
+void virtual_use_memory_arc(virtual_memory_t* memory_manager, process_t* process, long long int clock);
+void virtual_use_memory_ticks_arc(virtual_memory_t* memory_manager, process_t* process, long long int clock, long long int ticks);
+void virtual_memory_allocate_memory_CLOCK(virtual_memory_t* memory_manager, process_t* process, long long int clock);
+void virtual_memory_allocate_memory_WSCLOCK(virtual_memory_t* memory_manager, process_t* process, long long int clock);
+long long int CLOCK(virtual_memory_t* memory_manager, long long int ignore);
+long long int WSCLOCK(virtual_memory_t* memory_manager, long long int ignore);
+void virtual_use_memory_clock(virtual_memory_t* memory_manager, process_t* process, long long int clock);
+void virtual_use_memory_ticks_clock(virtual_memory_t* memory_manager, process_t* process, long long int clock, long long int ticks);
 long long int map(page_table_node_t * page_table, long long int frame_number);
 long long int virtual_memory_usage(virtual_memory_t* memory_manager);
 void virtual_print_addresses(virtual_memory_t* memory_manager, process_t* process);
 void aging(virtual_memory_t* memory_manager);
+void aging_ticks(virtual_memory_t* memory_manager, page_table_node_t* running, long long int ticks);
+unsigned int frame_counter(virtual_memory_t* memory_manager, long long int frame_number);
+page_table_node_t* get_page_table(virtual_memory_t* memory_manager, long long int pid);
+page_table_node_t* add_page_table(virtual_memory_t* memory_manager, long long int pid, long long int page_count);
+void virtual_use_memory(virtual_memory_t* memory_manager, process_t* process, long long int clock);
+void virtual_use_memory_ticks(virtual_memory_t* memory_manager, process_t* process, long long int clock, long long int ticks);
+void virtual_memory_load_process_ticks(virtual_memory_t* memory_manager, process_t* process, long long int ticks);
 
 void free_memory(virtual_memory_t* memory_manager);
 /**
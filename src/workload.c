@@ -0,0 +1,147 @@
+/**
+ * Workload module
+ * Reads processes one at a time as the simulation reaches their arrival time.
+ */
+
+#include "workload.h"
+
+#define WORKLOAD_INITIAL_BATCH 64
+
+/**
+ * Order of processes arriving at the same tick
+ * @param a
+ * @param b
+ * @return
+ */
+static int compare_batched_pid(const void* a, const void* b) {
+    long long int pid1 = (*(process_t* const*)a)->pid;
+    long long int pid2 = (*(process_t* const*)b)->pid;
+    return pid1 < pid2 ? -1 : pid1 > pid2;
+}
+
+/**
+ * Read the next record from the source into the lookahead slot
+ * @param workload
+ */
+static void workload_advance(workload_t* workload) {
+    long long int time, pid, memory, jobTime;
+    bool found;
+    if (workload->trace) {
+        found = trace_next(&workload->cursor, &time, &pid, &memory, &jobTime);
+    } else {
+        found = fscanf(workload->fp, "%lld %lld %lld %lld\n", &time, &pid, &memory, &jobTime) == 4;
+    }
+    if (found) {
+        workload->next = create_process(time, pid, memory, jobTime);
+        assert(workload->next);
+        workload->count++;
+    } else {
+        workload->next = NULL;
+    }
+}
+
+/**
+ * Open a text or binary workload
+ * @param fileName
+ * @return
+ */
+workload_t* open_workload(char* fileName) {
+    workload_t* workload = malloc(sizeof(*workload));
+    assert(workload);
+    workload->fp = NULL;
+    workload->trace = NULL;
+    workload->next = NULL;
+    workload->count = 0;
+    workload->batch_capacity = WORKLOAD_INITIAL_BATCH;
+    workload->batch = malloc(sizeof(*workload->batch) * workload->batch_capacity);
+    assert(workload->batch);
+
+    if (is_binary_trace(fileName)) {
+        workload->trace = open_trace(fileName);
+        trace_cursor_init(workload->trace, &workload->cursor);
+    } else {
+        workload->fp = fopen(fileName, "r"); // read mode
+        if (workload->fp == NULL) {
+            perror("Error while opening the file.\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+    workload_advance(workload);
+    return workload;
+}
+
+/**
+ * Close a workload and free processes that never arrived
+ * @param workload
+ */
+void close_workload(workload_t* workload) {
+    assert(workload);
+    if (workload->trace) {
+        close_trace(workload->trace);
+    }
+    if (workload->fp) {
+        fclose(workload->fp);
+    }
+    free_process(workload->next);
+    free(workload->batch);
+    free(workload);
+}
+
+/**
+ * Returns if there are processes yet to arrive
+ * @param workload
+ * @return
+ */
+bool workload_pending(workload_t* workload) {
+    return workload->next != NULL;
+}
+
+/**
+ * Returns the next process to arrive without removing it
+ * @param workload
+ * @return
+ */
+process_t* workload_next(workload_t* workload) {
+    return workload->next;
+}
+
+/**
+ * Remove and return the next process to arrive
+ * @param workload
+ * @return
+ */
+process_t* workload_pop(workload_t* workload) {
+    assert(workload->next);
+    process_t* process = workload->next;
+    workload_advance(workload);
+    return process;
+}
+
+/**
+ * Remove every process arriving at the given tick, sorted by pid.
+ * The processes are moved into a batch owned by the workload, which stays valid until the next call.
+ * @param workload
+ * @param clock
+ * @param arrivals set to the batch
+ * @return number of processes in the batch
+ */
+long long int workload_pop_arrivals(workload_t* workload, long long int clock, process_t*** arrivals) {
+    long long int count = 0;
+    bool sorted = true;
+    while (workload->next && workload->next->timeArrived == clock) {
+        if (count == workload->batch_capacity) {
+            workload->batch_capacity *= 2;
+            workload->batch = realloc(workload->batch, sizeof(*workload->batch) * workload->batch_capacity);
+            assert(workload->batch);
+        }
+        process_t* process = workload_pop(workload);
+        sorted = sorted && (count == 0 || workload->batch[count - 1]->pid < process->pid);
+        workload->batch[count++] = process;
+    }
+    /* Traces usually list a tick's arrivals in pid order already */
+    if (!sorted) {
+        qsort(workload->batch, count, sizeof(*workload->batch), compare_batched_pid);
+    }
+    *arrivals = workload->batch;
+    return count;
+}
@@ -0,0 +1,38 @@
+/**
+ * Workload module.
+ * Streams processes from a text or binary trace on demand, so that only the next arrival is kept in memory.
+ * Processes arriving at the same tick can be taken together as a batch sorted by pid.
+ */
+
+#ifndef SCHEDULER_WORKLOAD_H
+#define SCHEDULER_WORKLOAD_H
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <assert.h>
+#include "process.h"
+#include "trace.h"
+
+typedef struct workload {
+    /* Text source, NULL when reading a binary trace */
+    FILE* fp;
+    /* Binary source, NULL when reading a text file */
+    trace_t* trace;
+    trace_cursor_t cursor;
+    /* The next process to arrive, NULL once the source is exhausted */
+    process_t* next;
+    long long int count;
+    /* Reused for the arrivals of every tick, grown as needed */
+    process_t** batch;
+    long long int batch_capacity;
+} workload_t;
+
+workload_t* open_workload(char* fileName);
+void close_workload(workload_t* workload);
+bool workload_pending(workload_t* workload);
+process_t* workload_next(workload_t* workload);
+process_t* workload_pop(workload_t* workload);
+long long int workload_pop_arrivals(workload_t* workload, long long int clock, process_t*** arrivals);
+
+#endif //SCHEDULER_WORKLOAD_H
@@ -0,0 +1,144 @@
+//
+// Tests for lazy aging of the virtual memory frequency counters
+//
+
+#include "aging_test.h"
+#include "../src/virtual_memory.h"
+#include <stdio.h>
+
+#define AGING_TEST_MEMORY 64
+#define AGING_TEST_PROCESSES 40
+#define AGING_TEST_MAX_PAGES 10
+#define AGING_TEST_ROUNDS 600
+
+/*
+ * Counters aged eagerly on every tick, as virtual memory did before aging became lazy.
+ * Reference bits of pages that are not resident wait in pending until the page is mapped.
+ */
+typedef struct eager_aging {
+    unsigned int counter[AGING_TEST_MEMORY];
+    bool referenced[AGING_TEST_MEMORY];
+    bool pending[AGING_TEST_PROCESSES + 1][AGING_TEST_MAX_PAGES];
+    /* The pid and page each frame held after the previous step, pid 0 if none */
+    long long int pid[AGING_TEST_MEMORY];
+    long long int page[AGING_TEST_MEMORY];
+} eager_aging_t;
+
+/*
+ * Follow the frames the memory manager mapped and unmapped since the previous step.
+ * An unmapped page keeps its reference bit, a newly mapped frame starts from 0 with the bit of its page.
+ */
+void eager_follow_frames(eager_aging_t* eager, virtual_memory_t* memory_manager) {
+    for (long long int i = 0; i < memory_manager->total_frame; i++) {
+        frame_owner_t* owner = &memory_manager->frame_owners[i];
+        if (eager->pid[i] && (!owner->page_table || owner->page_table->pid != eager->pid[i] || owner->page != eager->page[i])) {
+            eager->pending[eager->pid[i]][eager->page[i]] = eager->referenced[i];
+            eager->pid[i] = 0;
+        }
+    }
+    for (long long int i = 0; i < memory_manager->total_frame; i++) {
+        frame_owner_t* owner = &memory_manager->frame_owners[i];
+        if (owner->page_table && !eager->pid[i]) {
+            eager->pid[i] = owner->page_table->pid;
+            eager->page[i] = owner->page;
+            eager->counter[i] = 0;
+            eager->referenced[i] = eager->pending[owner->page_table->pid][owner->page];
+            eager->pending[owner->page_table->pid][owner->page] = false;
+        }
+    }
+}
+
+/*
+ * One aging tick over every occupied frame
+ */
+void eager_age(eager_aging_t* eager, virtual_memory_t* memory_manager) {
+    for (long long int i = 0; i < memory_manager->total_frame; i++) {
+        if (eager->pid[i]) {
+            eager->counter[i] = (eager->counter[i] >> 1) | (eager->referenced[i] ? 0x80u : 0);
+        }
+        eager->referenced[i] = false;
+    }
+}
+
+/*
+ * The process references every page for the given number of ticks
+ */
+void eager_use(eager_aging_t* eager, virtual_memory_t* memory_manager, page_table_node_t* page_table, long long int ticks) {
+    for (long long int tick = 0; tick < ticks; tick++) {
+        for (long long int page = 0; page < page_table->page_count; page++) {
+            if (page_table->page_table_pointer[page].validity) {
+                eager->referenced[page_table->page_table_pointer[page].frame_number] = true;
+            } else {
+                eager->pending[page_table->pid][page] = true;
+            }
+        }
+        eager_age(eager, memory_manager);
+    }
+}
+
+/*
+ * Every occupied frame reads the counter the eager reference has
+ */
+void check_counters(eager_aging_t* eager, virtual_memory_t* memory_manager) {
+    for (long long int i = 0; i < memory_manager->total_frame; i++) {
+        if (eager->pid[i]) {
+            assert(frame_counter(memory_manager, i) == eager->counter[i]);
+        }
+    }
+}
+
+/*
+ * Random allocations, runs of one or more ticks and finishing processes, against the eager reference
+ */
+int test_lazy_aging_against_eager() {
+    memory_allocator_t* allocator = create_virtual_memory_allocator_LFU(AGING_TEST_MEMORY, PAGE_SIZE);
+    virtual_memory_t* memory_manager = allocator->structure;
+    assert(memory_manager->total_frame <= AGING_TEST_MEMORY);
+    eager_aging_t* eager = calloc(1, sizeof(*eager));
+    assert(eager);
+    process_t* processes[AGING_TEST_PROCESSES + 1];
+    bool finished[AGING_TEST_PROCESSES + 1] = {false};
+    srand(13);
+    for (int pid = 1; pid <= AGING_TEST_PROCESSES; pid++) {
+        processes[pid] = create_process(0, pid, PAGE_SIZE * (1 + rand() % AGING_TEST_MAX_PAGES), 100);
+    }
+    long long int clock = 0;
+    for (int round = 0; round < AGING_TEST_ROUNDS; round++) {
+        int pid = 1 + rand() % AGING_TEST_PROCESSES;
+        if (finished[pid]) {
+            continue;
+        }
+        process_t* process = processes[pid];
+        page_table_node_t* page_table = get_page_table(memory_manager, pid);
+        int action = rand() % 10;
+        if (!page_table || action < 2) {
+            allocator->malloc(memory_manager, process, clock);
+        } else if (action < 5) {
+            allocator->use(memory_manager, process, clock);
+            eager_use(eager, memory_manager, page_table, 1);
+            clock++;
+        } else if (action < 9) {
+            long long int ticks = 2 + rand() % 12;
+            allocator->use_ticks(memory_manager, process, clock, ticks);
+            eager_use(eager, memory_manager, page_table, ticks);
+            clock += ticks;
+        } else {
+            allocator->free(memory_manager, process, clock);
+            finished[pid] = true;
+        }
+        eager_follow_frames(eager, memory_manager);
+        check_counters(eager, memory_manager);
+    }
+    free_memory(memory_manager);
+    free(allocator);
+    free(eager);
+    for (int pid = 1; pid <= AGING_TEST_PROCESSES; pid++) {
+        free_process(processes[pid]);
+    }
+    return 0;
+}
+
+int aging_test() {
+    test_lazy_aging_against_eager();
+    return 0;
+}
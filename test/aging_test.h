@@ -0,0 +1,10 @@
+//
+// Tests for lazy aging of the virtual memory frequency counters
+//
+
+#ifndef SCHEDULER_AGING_TEST_H
+#define SCHEDULER_AGING_TEST_H
+
+int aging_test();
+
+#endif //SCHEDULER_AGING_TEST_H
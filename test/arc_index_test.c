@@ -0,0 +1,203 @@
+//
+// Tests for the ARC index
+//
+
+#include "arc_index_test.h"
+#include "../src/arc_index.h"
+
+#define ARC_TEST_FRAMES 4
+#define ARC_TEST_PAGES 10
+#define ARC_RANDOM_TEST_FRAMES 8
+#define ARC_RANDOM_TEST_PAGES 40
+#define ARC_RANDOM_TEST_ROUNDS 20000
+
+void assert_arc_sizes(arc_index_t* index, long long int t1, long long int t2, long long int b1, long long int b2,
+                      long long int target) {
+    assert(index->lists[ARC_T1].size == t1);
+    assert(index->lists[ARC_T2].size == t2);
+    assert(index->lists[ARC_B1].size == b1);
+    assert(index->lists[ARC_B2].size == b2);
+    assert(index->target == target);
+}
+
+/*
+ * Four frames driven through hits, ghost hits in B1 and B2 and evictions, checking every list and the target
+ */
+int test_arc_index_ghost_hits() {
+    arc_index_t* index = create_arc_index(ARC_TEST_FRAMES);
+    long long int ghosts[ARC_TEST_PAGES];
+    long long int owners[ARC_TEST_FRAMES] = {1, 1, 1, 1};
+    for (int page = 0; page < ARC_TEST_PAGES; page++) {
+        ghosts[page] = -1;
+    }
+    /* Pages 0 to 3 are loaded into frames 0 to 3 */
+    for (int frame = 0; frame < ARC_TEST_FRAMES; frame++) {
+        arc_index_insert(index, frame, &ghosts[frame]);
+    }
+    assert_arc_sizes(index, 4, 0, 0, 0, 0);
+
+    /* A second reference moves page 0 to T2, a first one keeps page 1 in T1 as most recently used */
+    arc_index_reference(index, 0, true);
+    arc_index_reference(index, 1, false);
+    assert_arc_sizes(index, 3, 1, 0, 0, 0);
+
+    /* T1 is over its target, so its least recently used frames are evicted into B1 */
+    assert(arc_index_replace(index, owners, -1) == 2);
+    arc_index_evict(index, 2, &ghosts[2]);
+    assert(ghosts[2] >= 0);
+    arc_index_insert(index, 2, &ghosts[4]);
+    assert(arc_index_replace(index, owners, -1) == 3);
+    arc_index_evict(index, 3, &ghosts[3]);
+    assert_arc_sizes(index, 2, 1, 2, 0, 0);
+
+    /* A ghost hit in B1 loads page 2 into T2 and grows the target of T1 */
+    arc_index_insert(index, 3, &ghosts[2]);
+    assert(ghosts[2] == -1);
+    assert_arc_sizes(index, 2, 2, 1, 0, 1);
+
+    assert(arc_index_replace(index, owners, -1) == 1);
+    arc_index_evict(index, 1, &ghosts[1]);
+    arc_index_insert(index, 1, &ghosts[5]);
+    assert_arc_sizes(index, 2, 2, 2, 0, 1);
+
+    /* Evicting page 0 from T2 leaves a ghost in B2, and a new page pushes the oldest B1 ghost out */
+    arc_index_evict(index, 0, &ghosts[0]);
+    assert_arc_sizes(index, 2, 1, 2, 1, 1);
+    arc_index_insert(index, 0, &ghosts[6]);
+    assert(ghosts[3] == -1);
+    assert(ghosts[1] >= 0);
+    assert_arc_sizes(index, 3, 1, 1, 1, 1);
+
+    /* A ghost hit in B2 shrinks the target by |B1| / |B2|, clamped at zero */
+    assert(arc_index_replace(index, owners, -1) == 2);
+    arc_index_evict(index, 2, &ghosts[4]);
+    arc_index_insert(index, 2, &ghosts[0]);
+    assert(ghosts[0] == -1);
+    assert_arc_sizes(index, 2, 2, 2, 0, 0);
+    assert(index->target_min == 0 && index->target_max == 1 && index->target_moved == 2);
+
+    /* Frames of the ignored pid are skipped, falling back to T2 */
+    owners[0] = 2;
+    owners[1] = 2;
+    assert(arc_index_replace(index, owners, 2) == 3);
+
+    /* A finished process frees its frames and forgets its ghosts */
+    arc_index_remove(index, 3);
+    arc_index_forget(index, &ghosts[1]);
+    assert(ghosts[1] == -1);
+    assert_arc_sizes(index, 2, 1, 1, 0, 0);
+    free_arc_index(index);
+    return 0;
+}
+
+/*
+ * A ghost hit in B1 grows the target by |B2| / |B1|, and a ghost hit in B2 then shrinks it by one
+ */
+int test_arc_index_adaptation() {
+    arc_index_t* index = create_arc_index(ARC_TEST_FRAMES);
+    long long int ghosts[ARC_TEST_PAGES];
+    long long int owners[ARC_TEST_FRAMES] = {1, 1, 1, 1};
+    for (int page = 0; page < ARC_TEST_PAGES; page++) {
+        ghosts[page] = -1;
+    }
+    /* Pages 0 to 3 are all referenced again, then pages 0 and 1 are evicted from T2 */
+    for (int frame = 0; frame < ARC_TEST_FRAMES; frame++) {
+        arc_index_insert(index, frame, &ghosts[frame]);
+        arc_index_reference(index, frame, true);
+    }
+    arc_index_evict(index, 0, &ghosts[0]);
+    arc_index_evict(index, 1, &ghosts[1]);
+    arc_index_insert(index, 0, &ghosts[4]);
+    arc_index_insert(index, 1, &ghosts[5]);
+    assert(arc_index_replace(index, owners, -1) == 0);
+    arc_index_evict(index, 0, &ghosts[4]);
+    assert_arc_sizes(index, 1, 2, 1, 2, 0);
+
+    arc_index_insert(index, 0, &ghosts[4]);
+    assert_arc_sizes(index, 1, 3, 0, 2, 2);
+
+    /* T1 is within its target, so T2 gives up its least recently used frame */
+    assert(arc_index_replace(index, owners, -1) == 2);
+    arc_index_evict(index, 2, &ghosts[2]);
+    arc_index_insert(index, 2, &ghosts[0]);
+    assert_arc_sizes(index, 1, 3, 0, 2, 1);
+    assert(index->target_min == 0 && index->target_max == 2 && index->target_moved == 3);
+    free_arc_index(index);
+    return 0;
+}
+
+/*
+ * Random references to more pages than frames, checking the ARC invariants after each one
+ */
+int test_arc_index_invariants() {
+    arc_index_t* index = create_arc_index(ARC_RANDOM_TEST_FRAMES);
+    long long int ghosts[ARC_RANDOM_TEST_PAGES];
+    bool referenced[ARC_RANDOM_TEST_PAGES];
+    long long int frame_of[ARC_RANDOM_TEST_PAGES];
+    long long int page_of[ARC_RANDOM_TEST_FRAMES];
+    long long int owners[ARC_RANDOM_TEST_FRAMES] = {0};
+    for (int page = 0; page < ARC_RANDOM_TEST_PAGES; page++) {
+        ghosts[page] = -1;
+        frame_of[page] = -1;
+    }
+    for (int frame = 0; frame < ARC_RANDOM_TEST_FRAMES; frame++) {
+        page_of[frame] = -1;
+    }
+    srand(16);
+    for (int round = 0; round < ARC_RANDOM_TEST_ROUNDS; round++) {
+        /* Low pages are referenced more often, so some pages are hot */
+        int page = rand() % (1 + rand() % ARC_RANDOM_TEST_PAGES);
+        if (rand() % 50 == 0) {
+            /* The page is freed by its process */
+            if (frame_of[page] >= 0) {
+                arc_index_remove(index, frame_of[page]);
+                page_of[frame_of[page]] = -1;
+                frame_of[page] = -1;
+            }
+            arc_index_forget(index, &ghosts[page]);
+        } else if (frame_of[page] >= 0) {
+            arc_index_reference(index, frame_of[page], referenced[page]);
+            referenced[page] = true;
+        } else {
+            long long int frame = -1;
+            for (int i = 0; i < ARC_RANDOM_TEST_FRAMES && frame < 0; i++) {
+                if (page_of[i] < 0) {
+                    frame = i;
+                }
+            }
+            if (frame < 0) {
+                frame = arc_index_replace(index, owners, -1);
+                arc_index_evict(index, frame, &ghosts[page_of[frame]]);
+                frame_of[page_of[frame]] = -1;
+            }
+            arc_index_insert(index, frame, &ghosts[page]);
+            page_of[frame] = page;
+            frame_of[page] = frame;
+            referenced[page] = false;
+        }
+
+        long long int resident = 0;
+        long long int ghost_count = 0;
+        for (int i = 0; i < ARC_RANDOM_TEST_PAGES; i++) {
+            resident += frame_of[i] >= 0;
+            ghost_count += ghosts[i] >= 0;
+            assert(frame_of[i] < 0 || ghosts[i] < 0);
+        }
+        arc_list_t* lists = index->lists;
+        assert(lists[ARC_T1].size + lists[ARC_T2].size == resident);
+        assert(lists[ARC_B1].size + lists[ARC_B2].size == ghost_count);
+        assert(lists[ARC_T1].size + lists[ARC_B1].size <= ARC_RANDOM_TEST_FRAMES);
+        assert(resident + ghost_count <= 2 * ARC_RANDOM_TEST_FRAMES);
+        assert(index->target >= 0 && index->target <= ARC_RANDOM_TEST_FRAMES);
+    }
+    assert(index->target_moved > 0);
+    free_arc_index(index);
+    return 0;
+}
+
+int arc_index_test() {
+    test_arc_index_ghost_hits();
+    test_arc_index_adaptation();
+    test_arc_index_invariants();
+    return 0;
+}
@@ -0,0 +1,10 @@
+//
+// Tests for the ARC index
+//
+
+#ifndef SCHEDULER_ARC_INDEX_TEST_H
+#define SCHEDULER_ARC_INDEX_TEST_H
+
+int arc_index_test();
+
+#endif //SCHEDULER_ARC_INDEX_TEST_H
@@ -0,0 +1,110 @@
+//
+// Tests for the ring buffer deque of the run queue
+//
+
+#include "deque_test.h"
+#include "../src/deque.h"
+#include <stdio.h>
+
+#define DEQUE_TEST_PROCESSES 200
+#define DEQUE_TEST_STEPS 50000
+
+/*
+ * Checks the deque holds the model from bottom to top, with its top and bottom where they are expected
+ */
+void check_deque(Deque *deque, tNode **model, int bottom, int top) {
+    assert(deque_size(deque) == top - bottom);
+    assert(deque->first >= 0 && deque->first < deque->capacity && deque->size <= deque->capacity);
+    for (int i = 0; i < top - bottom; i++) {
+        assert(deque->items[(deque->first + i) % deque->capacity] == model[bottom + i]);
+    }
+    assert(next_to_pop(deque) == (top > bottom ? model[top - 1] : NULL));
+    assert(last_to_pop(deque) == (top > bottom ? model[bottom] : NULL));
+}
+
+/*
+ * Bottom inserts wrap around to the end of the buffer at once, then the deque grows while it is wrapped
+ */
+int test_deque_wraparound() {
+    tNode processes[DEQUE_TEST_PROCESSES];
+    tNode *model[2 * DEQUE_TEST_PROCESSES];
+    int bottom = DEQUE_TEST_PROCESSES;
+    int top = DEQUE_TEST_PROCESSES;
+    Deque *deque = new_deque(NULL);
+    int capacity = deque->capacity;
+    /* Fill the buffer from both ends, so the bottom is at the end of the buffer and the top at its start */
+    for (int i = 0; i < capacity; i++) {
+        if (i % 2 == 0) {
+            deque_insert(deque, &processes[i]);
+            model[--bottom] = &processes[i];
+        } else {
+            deque_push(deque, &processes[i]);
+            model[top++] = &processes[i];
+        }
+        assert(deque->first != 0);
+        check_deque(deque, model, bottom, top);
+    }
+    assert(deque->capacity == capacity);
+    /* Growing from full with first != 0 has to unwrap the elements in order */
+    deque_push(deque, &processes[capacity]);
+    model[top++] = &processes[capacity];
+    assert(deque->capacity == 2 * capacity);
+    check_deque(deque, model, bottom, top);
+    deque_insert(deque, &processes[capacity + 1]);
+    model[--bottom] = &processes[capacity + 1];
+    check_deque(deque, model, bottom, top);
+    while (top > bottom) {
+        assert(deque_remove(deque) == model[bottom++]);
+        check_deque(deque, model, bottom, top);
+    }
+    free_deque(deque);
+    return 0;
+}
+
+/*
+ * Random pushes and removals at both ends against an array with room to grow either way
+ */
+int test_deque_random() {
+    tNode processes[DEQUE_TEST_PROCESSES];
+    tNode *model[2 * DEQUE_TEST_STEPS + 1];
+    int bottom = DEQUE_TEST_STEPS;
+    int top = DEQUE_TEST_STEPS;
+    Deque *deque = new_deque(NULL);
+    srand(22);
+    for (int step = 0; step < DEQUE_TEST_STEPS; step++) {
+        tNode *process = &processes[rand() % DEQUE_TEST_PROCESSES];
+        /* Adding slightly more often than removing grows the deque over the run */
+        switch (top > bottom ? rand() % 9 : rand() % 4) {
+            case 0:
+            case 1:
+                deque_push(deque, process);
+                model[top++] = process;
+                break;
+            case 2:
+            case 3:
+                deque_insert(deque, process);
+                model[--bottom] = process;
+                break;
+            case 4:
+            case 5:
+                assert(deque_pop(deque) == model[--top]);
+                break;
+            case 6:
+            case 7:
+                assert(deque_remove(deque) == model[bottom++]);
+                break;
+            default:
+                assert(next_to_pop(deque) == model[top - 1]);
+                break;
+        }
+        check_deque(deque, model, bottom, top);
+    }
+    free_deque(deque);
+    return 0;
+}
+
+int deque_test() {
+    test_deque_wraparound();
+    test_deque_random();
+    return 0;
+}
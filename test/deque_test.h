@@ -0,0 +1,10 @@
+//
+// Tests for the ring buffer deque of the run queue
+//
+
+#ifndef SCHEDULER_DEQUE_TEST_H
+#define SCHEDULER_DEQUE_TEST_H
+
+int deque_test();
+
+#endif //SCHEDULER_DEQUE_TEST_H
@@ -3,9 +3,16 @@
 //
 #include "../src/dlist.h"
 #include <assert.h>
+#include <stdio.h>
+
+int dlist_test_remove_head();
+int dlist_test_remove_tail();
+int dlist_test_remove_middle();
+int dlist_test_intrusive_link();
+int dlist_test_intrusive_remove();
 
 int dlist_test_insert_after_between() {
-    Dlist* list = new_dlist(empty_cleaner);
+    Dlist* list = new_dlist(empty_cleaner, NULL);
     int data1 = 1;
     int data2 = 2;
     int data3 = 3;
@@ -20,7 +27,7 @@ int dlist_test_insert_after_between() {
 }
 
 int dlist_test_insert_after_head() {
-    Dlist* list = new_dlist(empty_cleaner);
+    Dlist* list = new_dlist(empty_cleaner, NULL);
     int data1 = 1;
     int data3 = 3;
     Node* head = dlist_add_start(list, &data3);
@@ -33,7 +40,7 @@ int dlist_test_insert_after_head() {
 }
 
 int dlist_test_insert_after_tail() {
-    Dlist* list = new_dlist(empty_cleaner);
+    Dlist* list = new_dlist(empty_cleaner, NULL);
     int data1 = 1;
     int data2 = 2;
     int data3 = 3;
@@ -58,6 +65,8 @@ int dlist_test() {
     dlist_test_insert_after_head();
     dlist_test_insert_after_between();
     dlist_test_insert_after_tail();
+    dlist_test_intrusive_link();
+    dlist_test_intrusive_remove();
 
     return 0;
 }
@@ -71,7 +80,7 @@ void dlist_test_print(Dlist* list) {
 }
 
 int dlist_test_remove_head() {
-    Dlist* list = new_dlist(empty_cleaner);
+    Dlist* list = new_dlist(empty_cleaner, NULL);
     int data1 = 1;
     int data2 = 2;
     int data3 = 3;
@@ -89,7 +98,7 @@ int dlist_test_remove_head() {
 }
 
 int dlist_test_remove_tail() {
-    Dlist* list = new_dlist(empty_cleaner);
+    Dlist* list = new_dlist(empty_cleaner, NULL);
     int data1 = 1;
     int data2 = 2;
     int data3 = 3;
@@ -106,7 +115,7 @@ int dlist_test_remove_tail() {
 }
 
 int dlist_test_remove_middle() {
-    Dlist* list = new_dlist(empty_cleaner);
+    Dlist* list = new_dlist(empty_cleaner, NULL);
     int data1 = 1;
     int data2 = 2;
     int data3 = 3;
@@ -124,3 +133,71 @@ int dlist_test_remove_middle() {
     assert(list->tail == tail);
     assert(list->head == head);
 }
+
+/*
+ * Data of an intrusive list, counting how often the list cleaned it
+ */
+typedef struct dlist_test_item {
+    int value;
+    int cleaned;
+    Node node;
+} dlist_test_item_t;
+
+void dlist_test_clean_item(void* data) {
+    ((dlist_test_item_t*)data)->cleaned++;
+}
+
+int dlist_test_intrusive_link() {
+    Dlist* list = new_intrusive_dlist(dlist_test_clean_item, NULL);
+    dlist_test_item_t items[4] = {{1, 0}, {2, 0}, {3, 0}, {4, 0}};
+
+    Node* second = dlist_link_start(list, &items[1].node, &items[1]);
+    dlist_link_start(list, &items[0].node, &items[0]);
+    dlist_link_end(list, &items[3].node, &items[3]);
+    Node* third = dlist_link_after(list, second, &items[2].node, &items[2]);
+    assert(second == &items[1].node && third == &items[2].node);
+    assert(list->size == 4);
+    int value = 1;
+    for (Node* curr = list->head; curr; curr = curr->next) {
+        assert(((dlist_test_item_t*)curr->data)->value == value);
+        assert(curr->next == NULL || curr->next->prev == curr);
+        value++;
+    }
+    assert(list->tail == &items[3].node);
+
+    /* Freeing the list cleans every item once and leaves their nodes to them */
+    free_dlist(list);
+    for (int i = 0; i < 4; i++) {
+        assert(items[i].cleaned == 1);
+    }
+    return 0;
+}
+
+int dlist_test_intrusive_remove() {
+    Dlist* list = new_intrusive_dlist(dlist_test_clean_item, NULL);
+    dlist_test_item_t items[3] = {{1, 0}, {2, 0}, {3, 0}};
+    for (int i = 0; i < 3; i++) {
+        dlist_link_end(list, &items[i].node, &items[i]);
+    }
+
+    /* Removing cleans only the removed item and relinks its neighbours */
+    dlist_remove(list, &items[1].node);
+    assert(items[0].cleaned == 0 && items[1].cleaned == 1 && items[2].cleaned == 0);
+    assert(list->size == 2);
+    assert(list->head == &items[0].node && list->tail == &items[2].node);
+    assert(items[0].node.next == &items[2].node && items[2].node.prev == &items[0].node);
+
+    dlist_remove(list, &items[0].node);
+    assert(list->head == &items[2].node && items[2].node.prev == NULL);
+    dlist_remove(list, &items[2].node);
+    assert(list->size == 0 && list->head == NULL && list->tail == NULL);
+
+    /* A removed item can be linked again */
+    dlist_link_start(list, &items[1].node, &items[1]);
+    assert(list->size == 1 && list->head == &items[1].node && list->tail == &items[1].node);
+    free_dlist(list);
+    for (int i = 0; i < 3; i++) {
+        assert(items[i].cleaned == 1 + (i == 1));
+    }
+    return 0;
+}
@@ -0,0 +1,77 @@
+//
+// Tests for the hierarchical frame bitmap
+//
+
+#include "frame_bitmap_test.h"
+#include "../src/frame_bitmap.h"
+#include <stdio.h>
+
+#define FRAME_BITMAP_TEST_ROUNDS 4000
+
+/*
+ * The lowest set frame at or after from in a plain array of bits
+ */
+long long int linear_next(bool* bits, long long int frame_count, long long int from) {
+    for (long long int i = from; i < frame_count; i++) {
+        if (bits[i]) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/*
+ * Random sets and clears against a plain array of bits, checking lookups from random positions
+ * and from both sides of word boundaries
+ */
+int test_frame_bitmap_against_array(long long int frame_count, bool set) {
+    frame_bitmap_t* bitmap = create_frame_bitmap(frame_count, set);
+    bool* bits = malloc(sizeof(*bits) * frame_count);
+    assert(bits);
+    for (long long int i = 0; i < frame_count; i++) {
+        bits[i] = set;
+        assert(frame_bitmap_test(bitmap, i) == set);
+    }
+    srand(9);
+    for (int round = 0; round < FRAME_BITMAP_TEST_ROUNDS; round++) {
+        long long int frame_number = ((long long int)rand() * RAND_MAX + rand()) % frame_count;
+        /* Mostly clear, so long runs of empty words build up */
+        if (rand() % 4 == 0) {
+            frame_bitmap_set(bitmap, frame_number);
+            bits[frame_number] = true;
+        } else {
+            frame_bitmap_clear(bitmap, frame_number);
+            bits[frame_number] = false;
+        }
+        assert(frame_bitmap_test(bitmap, frame_number) == bits[frame_number]);
+        assert(frame_bitmap_lowest(bitmap) == linear_next(bits, frame_count, 0));
+        long long int from = ((long long int)rand() * RAND_MAX + rand()) % (frame_count + 1);
+        assert(frame_bitmap_next(bitmap, from) == linear_next(bits, frame_count, from));
+        long long int boundary = from - from % 64;
+        assert(frame_bitmap_next(bitmap, boundary) == linear_next(bits, frame_count, boundary));
+        if (boundary > 0) {
+            assert(frame_bitmap_next(bitmap, boundary - 1) == linear_next(bits, frame_count, boundary - 1));
+        }
+    }
+    /* Clearing everything leaves nothing to find */
+    for (long long int i = 0; i < frame_count; i++) {
+        frame_bitmap_clear(bitmap, i);
+    }
+    assert(frame_bitmap_lowest(bitmap) == -1);
+    frame_bitmap_set(bitmap, frame_count - 1);
+    assert(frame_bitmap_lowest(bitmap) == frame_count - 1);
+    assert(frame_bitmap_next(bitmap, frame_count) == -1);
+    free(bits);
+    free_frame_bitmap(bitmap);
+    return 0;
+}
+
+int frame_bitmap_search_test() {
+    /* One word, exactly one word, a partial second word, two levels, and three levels */
+    long long int frame_counts[] = {1, 63, 64, 65, 4096, 4097, 64 * 64 * 64 + 3};
+    for (int i = 0; i < 7; i++) {
+        test_frame_bitmap_against_array(frame_counts[i], true);
+        test_frame_bitmap_against_array(frame_counts[i], false);
+    }
+    return 0;
+}
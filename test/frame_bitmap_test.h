@@ -0,0 +1,10 @@
+//
+// Tests for the hierarchical frame bitmap
+//
+
+#ifndef SCHEDULER_FRAME_BITMAP_TEST_H
+#define SCHEDULER_FRAME_BITMAP_TEST_H
+
+int frame_bitmap_search_test();
+
+#endif //SCHEDULER_FRAME_BITMAP_TEST_H
@@ -0,0 +1,95 @@
+//
+// Tests for the furthest heap of the OPT policy
+//
+
+#include "furthest_heap_test.h"
+#include "../src/furthest_heap.h"
+#include "../src/virtual_memory.h"
+#include <stdio.h>
+
+#define FURTHEST_HEAP_TEST_PAGE_TABLES 64
+#define FURTHEST_HEAP_TEST_STEPS 20000
+
+/*
+ * Returns whether page table a is evicted before page table b
+ */
+static bool evicted_before(page_table_node_t* a, page_table_node_t* b) {
+    if (a->next_use != b->next_use) {
+        return a->next_use > b->next_use;
+    }
+    if (a->last_access != b->last_access) {
+        return a->last_access < b->last_access;
+    }
+    return a->created < b->created;
+}
+
+/*
+ * Returns the page table the heap should return, found by a scan of the page tables in the heap
+ */
+static page_table_node_t* linear_furthest(page_table_node_t** page_tables, bool* in_heap, int count, long long int ignore) {
+    page_table_node_t* furthest = NULL;
+    for (int i = 0; i < count; i++) {
+        if (in_heap[i] && page_tables[i]->pid != ignore && (!furthest || evicted_before(page_tables[i], furthest))) {
+            furthest = page_tables[i];
+        }
+    }
+    return furthest;
+}
+
+/*
+ * Gives a page table random keys from small ranges so that ties on next use and last access are common
+ */
+static void random_keys(page_table_node_t* page_table) {
+    page_table->next_use = rand() % 4 == 0 ? NEVER_USED : rand() % 8;
+    page_table->last_access = rand() % 8;
+}
+
+/*
+ * Random inserts, removals and key changes, checking the furthest page table after every step
+ */
+int test_furthest_heap_max() {
+    page_table_node_t* page_tables[FURTHEST_HEAP_TEST_PAGE_TABLES];
+    bool in_heap[FURTHEST_HEAP_TEST_PAGE_TABLES];
+    furthest_heap_t* heap = create_furthest_heap();
+    srand(18);
+    for (int i = 0; i < FURTHEST_HEAP_TEST_PAGE_TABLES; i++) {
+        page_tables[i] = create_page_table_node(i, 1);
+        page_tables[i]->created = FURTHEST_HEAP_TEST_PAGE_TABLES - i;
+        in_heap[i] = false;
+    }
+    assert(furthest_heap_max(heap, -1) == NULL);
+    for (int step = 0; step < FURTHEST_HEAP_TEST_STEPS; step++) {
+        int i = rand() % FURTHEST_HEAP_TEST_PAGE_TABLES;
+        if (!in_heap[i]) {
+            random_keys(page_tables[i]);
+            furthest_heap_insert(heap, page_tables[i]);
+            in_heap[i] = true;
+        } else if (rand() % 3 == 0) {
+            furthest_heap_remove(heap, page_tables[i]);
+            assert(page_tables[i]->furthest_index < 0);
+            in_heap[i] = false;
+        } else {
+            random_keys(page_tables[i]);
+            furthest_heap_update(heap, page_tables[i]);
+        }
+        page_table_node_t* furthest = linear_furthest(page_tables, in_heap, FURTHEST_HEAP_TEST_PAGE_TABLES, -1);
+        assert(furthest_heap_max(heap, -1) == furthest);
+        /* The furthest page table is skipped when it belongs to the running process */
+        if (furthest) {
+            assert(furthest_heap_max(heap, furthest->pid) == linear_furthest(page_tables, in_heap, FURTHEST_HEAP_TEST_PAGE_TABLES, furthest->pid));
+        }
+    }
+    for (int i = 0; i < FURTHEST_HEAP_TEST_PAGE_TABLES; i++) {
+        if (in_heap[i]) {
+            furthest_heap_remove(heap, page_tables[i]);
+        }
+        free_page_table_node(page_tables[i]);
+    }
+    free_furthest_heap(heap);
+    return 0;
+}
+
+int furthest_heap_test() {
+    test_furthest_heap_max();
+    return 0;
+}
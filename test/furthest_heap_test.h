@@ -0,0 +1,10 @@
+//
+// Tests for the furthest heap of the OPT policy
+//
+
+#ifndef SCHEDULER_FURTHEST_HEAP_TEST_H
+#define SCHEDULER_FURTHEST_HEAP_TEST_H
+
+int furthest_heap_test();
+
+#endif //SCHEDULER_FURTHEST_HEAP_TEST_H
@@ -0,0 +1,186 @@
+//
+// Tests for the generation index of the MGLRU policy
+//
+
+#include "generation_index_test.h"
+#include "../src/generation_index.h"
+#include <stdio.h>
+
+#define GENERATION_INDEX_TEST_FRAMES 48
+#define GENERATION_INDEX_TEST_PIDS 4
+#define GENERATION_INDEX_TEST_STEPS 30000
+
+/*
+ * Generations of the frames kept without lists: a frame is in the generation it was last inserted or referenced in,
+ * or in the oldest one once that has passed it
+ */
+typedef struct generation_model {
+    long long int min_seq;
+    long long int max_seq;
+    long long int aged_at;
+    long long int generation[GENERATION_INDEX_TEST_FRAMES];
+    long long int owners[GENERATION_INDEX_TEST_FRAMES];
+} generation_model_t;
+
+/*
+ * The generation a frame is in, -1 if it is not occupied
+ */
+static long long int model_generation(generation_model_t* model, long long int frame_number) {
+    if (model->owners[frame_number] < 0) {
+        return -1;
+    }
+    return model->generation[frame_number] > model->min_seq ? model->generation[frame_number] : model->min_seq;
+}
+
+/*
+ * Ages the model once for every interval passed, keeping at most MGLRU_GENERATIONS generations
+ */
+static void model_advance(generation_model_t* model, long long int clock) {
+    long long int intervals = (clock - model->aged_at) / MGLRU_AGING_INTERVAL;
+    if (intervals <= 0) {
+        return;
+    }
+    model->aged_at += intervals * MGLRU_AGING_INTERVAL;
+    model->max_seq += intervals < MGLRU_GENERATIONS ? intervals : MGLRU_GENERATIONS;
+    if (model->max_seq - model->min_seq >= MGLRU_GENERATIONS) {
+        model->min_seq = model->max_seq - MGLRU_GENERATIONS + 1;
+    }
+}
+
+/*
+ * Checks a frame returned for eviction against the model and moves the model past the generations that were emptied
+ */
+static void check_oldest(generation_index_t* index, generation_model_t* model, long long int frame_number, long long int ignore) {
+    long long int oldest = -1;
+    for (long long int i = 0; i < GENERATION_INDEX_TEST_FRAMES; i++) {
+        if (model->owners[i] >= 0 && model->owners[i] != ignore && (oldest < 0 || model_generation(model, i) < oldest)) {
+            oldest = model_generation(model, i);
+        }
+    }
+    if (oldest < 0) {
+        /* One pass over every generation found nothing */
+        assert(frame_number == -1);
+        oldest = model->min_seq + MGLRU_GENERATIONS - 1;
+        model->min_seq = oldest + 1;
+    } else {
+        assert(frame_number >= 0 && frame_number < GENERATION_INDEX_TEST_FRAMES);
+        assert(model->owners[frame_number] >= 0 && model->owners[frame_number] != ignore);
+        assert(model_generation(model, frame_number) == oldest);
+        /* Generations older than the evicted frame were emptied on the way */
+        model->min_seq = oldest;
+    }
+    if (model->max_seq <= oldest) {
+        model->max_seq = oldest + 1;
+    }
+    assert(index->min_seq == model->min_seq && index->max_seq == model->max_seq);
+    /* Frames of the ignored process passed on the way are postponed, at most to the generation after the evicted frame.
+     * How far each one went depends on the order of the lists, so the model takes it from the index. */
+    for (long long int i = 0; i < GENERATION_INDEX_TEST_FRAMES; i++) {
+        if (model->owners[i] == ignore) {
+            long long int generation = index->seq[i] > model->min_seq ? index->seq[i] : model->min_seq;
+            assert(generation == model_generation(model, i) || (generation > model_generation(model, i) && generation <= oldest + 1));
+            model->generation[i] = index->seq[i];
+        }
+    }
+}
+
+/*
+ * Random loads, references, agings and evictions, checking every eviction takes a frame of the oldest generation
+ */
+int test_generation_index_oldest() {
+    generation_index_t* index = create_generation_index(GENERATION_INDEX_TEST_FRAMES);
+    generation_model_t model = {0, 0, 0};
+    srand(19);
+    for (long long int i = 0; i < GENERATION_INDEX_TEST_FRAMES; i++) {
+        model.owners[i] = -1;
+    }
+    long long int clock = 0;
+    for (int step = 0; step < GENERATION_INDEX_TEST_STEPS; step++) {
+        long long int frame_number = rand() % GENERATION_INDEX_TEST_FRAMES;
+        int action = rand() % 10;
+        if (action < 3) {
+            if (model.owners[frame_number] < 0) {
+                generation_index_insert(index, frame_number);
+                model.owners[frame_number] = rand() % GENERATION_INDEX_TEST_PIDS;
+                model.generation[frame_number] = model.max_seq;
+            }
+        } else if (action < 6) {
+            if (model.owners[frame_number] >= 0) {
+                generation_index_reference(index, frame_number);
+                model.generation[frame_number] = model.max_seq;
+            }
+        } else if (action < 7) {
+            generation_index_remove(index, frame_number);
+            model.owners[frame_number] = -1;
+        } else if (action < 8) {
+            /* Mostly single intervals, sometimes enough to merge every generation */
+            clock += rand() % 8 == 0 ? rand() % (MGLRU_AGING_INTERVAL * (MGLRU_GENERATIONS + 2)) : rand() % (MGLRU_AGING_INTERVAL + 1);
+            generation_index_advance(index, clock);
+            model_advance(&model, clock);
+            assert(index->min_seq == model.min_seq && index->max_seq == model.max_seq);
+        } else {
+            long long int ignore = rand() % (GENERATION_INDEX_TEST_PIDS + 1);
+            long long int oldest = generation_index_oldest(index, model.owners, ignore);
+            check_oldest(index, &model, oldest, ignore);
+            if (oldest >= 0 && rand() % 2 == 0) {
+                generation_index_remove(index, oldest);
+                model.owners[oldest] = -1;
+            }
+        }
+    }
+    free_generation_index(index);
+    return 0;
+}
+
+/*
+ * Frames of one generation are evicted in the order they were loaded, and referenced frames are skipped
+ */
+int test_generation_index_order() {
+    long long int owners[GENERATION_INDEX_TEST_FRAMES];
+    generation_index_t* index = create_generation_index(GENERATION_INDEX_TEST_FRAMES);
+    for (long long int i = 0; i < 5; i++) {
+        owners[i] = i;
+        generation_index_insert(index, i);
+    }
+    generation_index_advance(index, MGLRU_AGING_INTERVAL);
+    generation_index_reference(index, 0);
+    assert(generation_index_oldest(index, owners, -1) == 1);
+    /* The frame of the running process is skipped */
+    assert(generation_index_oldest(index, owners, 1) == 2);
+    generation_index_remove(index, 2);
+    generation_index_remove(index, 3);
+    assert(generation_index_oldest(index, owners, -1) == 4);
+    generation_index_remove(index, 4);
+    /* Frame 1 was postponed behind frame 0, which was moved when it was passed */
+    assert(generation_index_oldest(index, owners, -1) == 0);
+    generation_index_remove(index, 0);
+    assert(generation_index_oldest(index, owners, -1) == 1);
+    free_generation_index(index);
+    return 0;
+}
+
+/*
+ * Every occupied frame belonging to the running process leaves nothing to evict
+ */
+int test_generation_index_all_ignored() {
+    long long int owners[GENERATION_INDEX_TEST_FRAMES];
+    generation_index_t* index = create_generation_index(GENERATION_INDEX_TEST_FRAMES);
+    assert(generation_index_oldest(index, owners, -1) == -1);
+    for (long long int i = 0; i < 3; i++) {
+        owners[i] = 7;
+        generation_index_insert(index, i);
+        generation_index_advance(index, (i + 1) * MGLRU_AGING_INTERVAL);
+    }
+    assert(generation_index_oldest(index, owners, 7) == -1);
+    /* Passing the older frames moved them behind the youngest one */
+    assert(generation_index_oldest(index, owners, -1) == 2);
+    free_generation_index(index);
+    return 0;
+}
+
+int generation_index_test() {
+    test_generation_index_order();
+    test_generation_index_all_ignored();
+    test_generation_index_oldest();
+    return 0;
+}
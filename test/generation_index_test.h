@@ -0,0 +1,10 @@
+//
+// Tests for the generation index of the MGLRU policy
+//
+
+#ifndef SCHEDULER_GENERATION_INDEX_TEST_H
+#define SCHEDULER_GENERATION_INDEX_TEST_H
+
+int generation_index_test();
+
+#endif //SCHEDULER_GENERATION_INDEX_TEST_H
@@ -0,0 +1,130 @@
+//
+// Tests for the generic d-ary heap
+//
+
+#include "heap_test.h"
+#include "../src/heap.h"
+#include <stdio.h>
+
+#define HEAP_TEST_ITEMS 500
+#define HEAP_TEST_ROUNDS 2000
+
+typedef struct heap_test_item {
+    long long int key;
+    long long int heap_index;
+} heap_test_item_t;
+
+int compare_heap_test_items(void* a, void* b) {
+    long long int key_a = ((heap_test_item_t*)a)->key;
+    long long int key_b = ((heap_test_item_t*)b)->key;
+    return key_a < key_b ? -1 : key_a > key_b ? 1 : 0;
+}
+
+int compare_keys(const void* a, const void* b) {
+    long long int key_a = *(const long long int*)a;
+    long long int key_b = *(const long long int*)b;
+    return key_a < key_b ? -1 : key_a > key_b ? 1 : 0;
+}
+
+/*
+ * Pops every item and checks the keys come out in the order of a sorted copy
+ */
+void drain_in_order(heap_t* heap, heap_test_item_t* items, int* in_heap, int count) {
+    long long int expected[HEAP_TEST_ITEMS];
+    int size = 0;
+    for (int i = 0; i < count; i++) {
+        if (in_heap[i]) {
+            expected[size++] = items[i].key;
+        }
+    }
+    assert(heap_size(heap) == size);
+    qsort(expected, size, sizeof(*expected), compare_keys);
+    for (int i = 0; i < size; i++) {
+        heap_test_item_t* item = heap_pop_min(heap);
+        assert(item->key == expected[i]);
+        assert(item->heap_index == -1);
+        in_heap[item - items] = 0;
+    }
+    assert(heap_size(heap) == 0);
+    assert(heap_peek_min(heap) == NULL);
+}
+
+/*
+ * Random inserts, decrease-keys, key updates and removals against a sorted reference
+ */
+int test_d_ary_heap(int arity) {
+    heap_test_item_t items[HEAP_TEST_ITEMS];
+    int in_heap[HEAP_TEST_ITEMS] = {0};
+    heap_t* heap = create_d_ary_heap(1, arity, compare_heap_test_items, offsetof(heap_test_item_t, heap_index));
+    srand(arity);
+    for (int round = 0; round < HEAP_TEST_ROUNDS; round++) {
+        int i = rand() % HEAP_TEST_ITEMS;
+        if (!in_heap[i]) {
+            items[i].key = rand() % 1000;
+            items[i].heap_index = -1;
+            heap_insert(heap, &items[i]);
+            in_heap[i] = 1;
+            continue;
+        }
+        assert(items[i].heap_index >= 0 && heap->arr[items[i].heap_index] == &items[i]);
+        switch (rand() % 3) {
+            case 0:
+                items[i].key -= rand() % 100;
+                heap_decrease_key(heap, &items[i]);
+                break;
+            case 1:
+                items[i].key += rand() % 200 - 100;
+                heap_update_key(heap, &items[i]);
+                break;
+            default:
+                heap_remove(heap, &items[i]);
+                assert(items[i].heap_index == -1);
+                in_heap[i] = 0;
+        }
+        heap_test_item_t* min = heap_peek_min(heap);
+        heap_test_item_t* second = heap_peek_second(heap);
+        for (int j = 0; j < HEAP_TEST_ITEMS; j++) {
+            if (in_heap[j]) {
+                assert(min->key <= items[j].key);
+                assert(&items[j] == min || second->key <= items[j].key);
+            }
+        }
+    }
+    drain_in_order(heap, items, in_heap, HEAP_TEST_ITEMS);
+    free_heap(heap);
+    return 0;
+}
+
+/*
+ * Heap without position fields, as used for suspended processes
+ */
+int test_heap_without_index() {
+    heap_test_item_t items[HEAP_TEST_ITEMS];
+    heap_t* heap = create_heap(1, compare_heap_test_items);
+    srand(1);
+    for (int i = 0; i < HEAP_TEST_ITEMS; i++) {
+        items[i].key = rand() % 50;
+        items[i].heap_index = -1;
+        heap_insert(heap, &items[i]);
+    }
+    for (int i = 0; i < HEAP_TEST_ITEMS; i++) {
+        assert(items[i].heap_index == -1);
+    }
+    long long int previous = -1;
+    while (heap_size(heap) > 0) {
+        heap_test_item_t* item = heap_pop_min(heap);
+        assert(item->key >= previous);
+        previous = item->key;
+    }
+    free_heap(heap);
+    return 0;
+}
+
+int heap_test() {
+    test_heap_without_index();
+    test_d_ary_heap(2);
+    test_d_ary_heap(3);
+    test_d_ary_heap(4);
+    test_d_ary_heap(8);
+    return 0;
+}
@@ -0,0 +1,10 @@
+//
+// Tests for the generic d-ary heap
+//
+
+#ifndef SCHEDULER_HEAP_TEST_H
+#define SCHEDULER_HEAP_TEST_H
+
+int heap_test();
+
+#endif //SCHEDULER_HEAP_TEST_H
@@ -0,0 +1,82 @@
+//
+// Tests for the hole index of the memory list
+//
+
+#include "hole_index_test.h"
+#include "../src/hole_index.h"
+#include "../src/swapping.h"
+#include <stdio.h>
+
+#define HOLE_INDEX_TEST_PROCESSES 64
+#define HOLE_INDEX_TEST_ROUNDS 3000
+#define HOLE_INDEX_TEST_MEMORY 4000
+#define HOLE_INDEX_TEST_PAGE_SIZE 4
+
+/*
+ * The first hole from the head of the memory list with at least the given number of pages
+ */
+Node* linear_first_fit(memory_list_t* mem_list, long long int pages_required) {
+    for (Node* node = mem_list->list->head; node; node = node->next) {
+        memory_fragment_t* fragment = (memory_fragment_t*) node->data;
+        if (fragment->type == HOLE_FRAGMENT && fragment->page_length >= pages_required) {
+            return node;
+        }
+    }
+    return NULL;
+}
+
+/*
+ * Every request size, up to one more page than the memory has, gets the hole a linear scan would find
+ */
+void check_first_fit(memory_list_t* mem_list) {
+    long long int holes = 0;
+    for (Node* node = mem_list->list->head; node; node = node->next) {
+        if (((memory_fragment_t*) node->data)->type == HOLE_FRAGMENT) {
+            holes++;
+        }
+    }
+    assert(mem_list->holes->size == holes);
+    long long int total_pages = HOLE_INDEX_TEST_MEMORY / HOLE_INDEX_TEST_PAGE_SIZE;
+    for (long long int pages = 1; pages <= total_pages + 1; pages++) {
+        assert(hole_index_first_fit(mem_list->holes, pages) == linear_first_fit(mem_list, pages));
+    }
+}
+
+/*
+ * Random allocations and evictions, where evictions merge neighbouring holes
+ */
+int test_hole_index_first_fit() {
+    memory_list_t* mem_list = create_memory_list(HOLE_INDEX_TEST_MEMORY, HOLE_INDEX_TEST_PAGE_SIZE);
+    process_t* processes[HOLE_INDEX_TEST_PROCESSES];
+    Node* allocated[HOLE_INDEX_TEST_PROCESSES] = {NULL};
+    srand(4);
+    for (int i = 0; i < HOLE_INDEX_TEST_PROCESSES; i++) {
+        processes[i] = create_process(0, i, 4 + rand() % 400, 1);
+    }
+    check_first_fit(mem_list);
+    for (int round = 0; round < HOLE_INDEX_TEST_ROUNDS; round++) {
+        int i = rand() % HOLE_INDEX_TEST_PROCESSES;
+        if (allocated[i]) {
+            evict(mem_list, allocated[i]);
+            allocated[i] = NULL;
+        } else {
+            Node* hole = first_fit(mem_list, processes[i]);
+            long long int pages_required = byteToRequiredPage(processes[i]->memory, HOLE_INDEX_TEST_PAGE_SIZE);
+            assert(hole == linear_first_fit(mem_list, pages_required));
+            if (hole) {
+                allocated[i] = allocate(mem_list, hole, processes[i]);
+            }
+        }
+        check_first_fit(mem_list);
+    }
+    free_memory_list(mem_list);
+    for (int i = 0; i < HOLE_INDEX_TEST_PROCESSES; i++) {
+        free_process(processes[i]);
+    }
+    return 0;
+}
+
+int hole_index_test() {
+    test_hole_index_first_fit();
+    return 0;
+}
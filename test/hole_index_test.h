@@ -0,0 +1,10 @@
+//
+// Tests for the hole index of the memory list
+//
+
+#ifndef SCHEDULER_HOLE_INDEX_TEST_H
+#define SCHEDULER_HOLE_INDEX_TEST_H
+
+int hole_index_test();
+
+#endif //SCHEDULER_HOLE_INDEX_TEST_H
@@ -0,0 +1,123 @@
+//
+// Tests for the LFU index
+//
+
+#include "lfu_index_test.h"
+#include "../src/lfu_index.h"
+#include <stdio.h>
+
+#define LFU_TEST_FRAMES 200
+#define LFU_TEST_PIDS 6
+#define LFU_TEST_ROUNDS 20000
+
+/*
+ * The occupied frame with the lowest aged counter not owned by ignore, the lowest frame on ties
+ */
+long long int linear_lfu_min(long long int frame_count, unsigned int* counters, long long int* aged_at, long long int epoch,
+                             long long int* owners, long long int ignore) {
+    long long int victim = -1;
+    unsigned int min_freq = 0;
+    for (long long int i = 0; i < frame_count; i++) {
+        if (owners[i] < 0 || owners[i] == ignore) {
+            continue;
+        }
+        long long int owed = epoch - aged_at[i];
+        unsigned int freq = counters[i] >> (owed < MAX_AGING_SHIFT ? owed : MAX_AGING_SHIFT);
+        if (victim < 0 || freq < min_freq) {
+            victim = i;
+            min_freq = freq;
+        }
+    }
+    return victim;
+}
+
+/*
+ * Random mapping, referencing, freeing and aging of frames, checking the minimum after every step.
+ * With few frames referenced often, most lookups find no idle frame and search the calendar.
+ */
+int test_lfu_index_min(unsigned int seed, long long int frame_count, int reference_percent) {
+    assert(frame_count <= LFU_TEST_FRAMES);
+    lfu_index_t* index = create_lfu_index(frame_count);
+    unsigned int counters[LFU_TEST_FRAMES] = {0};
+    long long int aged_at[LFU_TEST_FRAMES] = {0};
+    long long int owners[LFU_TEST_FRAMES];
+    long long int epoch = 0;
+    for (int i = 0; i < LFU_TEST_FRAMES; i++) {
+        owners[i] = -1;
+    }
+    srand(seed);
+    for (int round = 0; round < LFU_TEST_ROUNDS; round++) {
+        long long int frame_number = rand() % frame_count;
+        int action = rand() % 100;
+        if (owners[frame_number] < 0 && action < 50) {
+            /* Map a frame, usually referenced as soon as it is mapped */
+            owners[frame_number] = rand() % LFU_TEST_PIDS;
+            counters[frame_number] = rand() % 8 ? 0x80u >> (rand() % 3) : 0;
+            aged_at[frame_number] = epoch;
+            lfu_index_track(index, frame_number, counters[frame_number], epoch, epoch);
+        } else if (action < reference_percent && owners[frame_number] >= 0) {
+            /* Age a referenced frame, whose counter may still owe shifts */
+            long long int owed = epoch - aged_at[frame_number];
+            unsigned int counter = counters[frame_number] >> (owed < MAX_AGING_SHIFT ? owed : MAX_AGING_SHIFT);
+            counters[frame_number] = counter | (0x80u >> (rand() % 3));
+            aged_at[frame_number] = epoch;
+            lfu_index_track(index, frame_number, counters[frame_number], aged_at[frame_number], epoch);
+        } else if (action < reference_percent + 5 && owners[frame_number] >= 0) {
+            owners[frame_number] = -1;
+            lfu_index_untrack(index, frame_number);
+        } else if (action >= 98) {
+            /* Mostly single ticks, sometimes more ticks than the calendar has slots */
+            long long int ticks = rand() % 4 ? 1 : 1 + rand() % (3 * LFU_INDEX_SLOTS);
+            lfu_index_advance(index, epoch, epoch + ticks);
+            epoch += ticks;
+        }
+        long long int ignore = rand() % (LFU_TEST_PIDS + 1);
+        assert(lfu_index_min(index, counters, aged_at, epoch, owners, ignore)
+               == linear_lfu_min(frame_count, counters, aged_at, epoch, owners, ignore));
+    }
+    free_lfu_index(index);
+    return 0;
+}
+
+/*
+ * A frame whose counter ages to 0 beats any counting frame, and the ignored process is skipped
+ */
+int test_lfu_index_idle_frames() {
+    lfu_index_t* index = create_lfu_index(LFU_TEST_FRAMES);
+    unsigned int counters[LFU_TEST_FRAMES] = {0};
+    long long int aged_at[LFU_TEST_FRAMES] = {0};
+    long long int owners[LFU_TEST_FRAMES];
+    for (int i = 0; i < LFU_TEST_FRAMES; i++) {
+        owners[i] = -1;
+    }
+    owners[3] = 1;
+    owners[7] = 2;
+    counters[3] = 0x80;
+    counters[7] = 0x01;
+    lfu_index_track(index, 3, counters[3], 0, 0);
+    lfu_index_track(index, 7, counters[7], 0, 0);
+    assert(lfu_index_min(index, counters, aged_at, 0, owners, -1) == 7);
+    assert(lfu_index_min(index, counters, aged_at, 0, owners, 2) == 3);
+
+    /* After one tick frame 7 is idle, after eight frame 3 is too and the lower frame wins */
+    lfu_index_advance(index, 0, 1);
+    assert(frame_bitmap_test(index->idle_frames, 7) && !frame_bitmap_test(index->idle_frames, 3));
+    lfu_index_advance(index, 1, 8);
+    assert(frame_bitmap_test(index->idle_frames, 3));
+    assert(lfu_index_min(index, counters, aged_at, 8, owners, -1) == 3);
+    assert(lfu_index_min(index, counters, aged_at, 8, owners, 1) == 7);
+
+    lfu_index_untrack(index, 3);
+    owners[3] = -1;
+    assert(lfu_index_min(index, counters, aged_at, 8, owners, 2) == -1);
+    free_lfu_index(index);
+    return 0;
+}
+
+int lfu_index_test() {
+    test_lfu_index_idle_frames();
+    test_lfu_index_min(14, LFU_TEST_FRAMES, 60);
+    test_lfu_index_min(15, LFU_TEST_FRAMES, 90);
+    test_lfu_index_min(16, 12, 95);
+    return 0;
+}
@@ -0,0 +1,10 @@
+//
+// Tests for the LFU index
+//
+
+#ifndef SCHEDULER_LFU_INDEX_TEST_H
+#define SCHEDULER_LFU_INDEX_TEST_H
+
+int lfu_index_test();
+
+#endif //SCHEDULER_LFU_INDEX_TEST_H
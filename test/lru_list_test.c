@@ -0,0 +1,82 @@
+//
+// Tests for the recency list of the LRU policy
+//
+
+#include "lru_list_test.h"
+#include "../src/lru_list.h"
+#include <stdio.h>
+
+#define LRU_LIST_TEST_FRAMES 40
+#define LRU_LIST_TEST_PIDS 5
+#define LRU_LIST_TEST_STEPS 20000
+
+/*
+ * The least recently touched listed frame not owned by the ignored pid, found by a scan of the touch times
+ */
+long long int linear_lru_oldest(long long int* touched_at, long long int* owners, long long int ignore) {
+    long long int oldest = -1;
+    for (long long int i = 0; i < LRU_LIST_TEST_FRAMES; i++) {
+        if (touched_at[i] >= 0 && owners[i] != ignore && (oldest < 0 || touched_at[i] < touched_at[oldest])) {
+            oldest = i;
+        }
+    }
+    return oldest;
+}
+
+/*
+ * Walks the list both ways, checking it holds the listed frames from least to most recently touched
+ */
+void check_lru_order(lru_list_t* list, long long int* touched_at) {
+    long long int count = 0;
+    long long int last = -1;
+    for (long long int frame_number = list->head; frame_number >= 0; frame_number = list->next[frame_number]) {
+        assert(list->listed[frame_number] && touched_at[frame_number] >= 0);
+        assert(list->prev[frame_number] == last);
+        assert(last < 0 || touched_at[last] < touched_at[frame_number]);
+        last = frame_number;
+        count++;
+    }
+    assert(list->tail == last);
+    for (long long int i = 0; i < LRU_LIST_TEST_FRAMES; i++) {
+        if (touched_at[i] >= 0) {
+            count--;
+        }
+    }
+    assert(count == 0);
+}
+
+/*
+ * Random touches and removals, including touches of the most recently used frame
+ */
+int test_lru_list_oldest() {
+    long long int touched_at[LRU_LIST_TEST_FRAMES];
+    long long int owners[LRU_LIST_TEST_FRAMES];
+    lru_list_t* list = create_lru_list(LRU_LIST_TEST_FRAMES);
+    srand(20);
+    for (long long int i = 0; i < LRU_LIST_TEST_FRAMES; i++) {
+        touched_at[i] = -1;
+        owners[i] = rand() % LRU_LIST_TEST_PIDS;
+    }
+    assert(lru_list_oldest(list, owners, -1) == -1);
+    for (long long int step = 0; step < LRU_LIST_TEST_STEPS; step++) {
+        long long int frame_number = rand() % 4 == 0 && list->tail >= 0 ? list->tail : rand() % LRU_LIST_TEST_FRAMES;
+        if (rand() % 4 == 0) {
+            lru_list_remove(list, frame_number);
+            touched_at[frame_number] = -1;
+        } else {
+            lru_list_touch(list, frame_number);
+            touched_at[frame_number] = step;
+        }
+        check_lru_order(list, touched_at);
+        for (long long int ignore = -1; ignore < LRU_LIST_TEST_PIDS; ignore++) {
+            assert(lru_list_oldest(list, owners, ignore) == linear_lru_oldest(touched_at, owners, ignore));
+        }
+    }
+    free_lru_list(list);
+    return 0;
+}
+
+int lru_list_test() {
+    test_lru_list_oldest();
+    return 0;
+}
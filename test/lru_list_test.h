@@ -0,0 +1,10 @@
+//
+// Tests for the recency list of the LRU policy
+//
+
+#ifndef SCHEDULER_LRU_LIST_TEST_H
+#define SCHEDULER_LRU_LIST_TEST_H
+
+int lru_list_test();
+
+#endif //SCHEDULER_LRU_LIST_TEST_H
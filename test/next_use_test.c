@@ -0,0 +1,94 @@
+//
+// Tests for the recorded schedule of the OPT policy
+//
+
+#include "next_use_test.h"
+#include "../src/next_use.h"
+#include <stdio.h>
+
+#define NEXT_USE_TEST_PIDS 8
+#define NEXT_USE_TEST_RUNS 2000
+
+/*
+ * Runs are split where the process changes or a tick is skipped, and are looked up by run rather than tick
+ */
+int test_next_use_runs() {
+    next_use_t* schedule = create_next_use();
+    /* Run 1 is pid 1 over ticks 0 to 4, observed in two parts */
+    next_use_observe(schedule, 1, 0, 2);
+    next_use_observe(schedule, 1, 3, 4);
+    next_use_observe(schedule, 2, 5, 5);
+    next_use_observe(schedule, 1, 6, 8);
+    next_use_observe(schedule, 3, 9, 9);
+    /* Tick 10 is idle, so pid 3 starts a new run */
+    next_use_observe(schedule, 3, 11, 11);
+    next_use_observe(schedule, 2, 12, 12);
+    assert(schedule->run_count == 6);
+    /* Nothing is known until the recording is replayed */
+    assert(next_use_of(schedule, 1) == NEVER_USED);
+
+    next_use_replay(schedule);
+    assert(next_use_of(schedule, 1) == 1);
+    assert(next_use_of(schedule, 2) == 2);
+    assert(next_use_of(schedule, 3) == 4);
+    assert(next_use_of(schedule, 4) == NEVER_USED);
+    next_use_observe(schedule, 1, 0, 0);
+    assert(next_use_of(schedule, 1) == 3);
+    /* Pid 1 runs once more than recorded, which uses up its runs without moving the others */
+    next_use_observe(schedule, 1, 2, 2);
+    assert(next_use_of(schedule, 1) == NEVER_USED);
+    assert(next_use_of(schedule, 2) == 2);
+    next_use_observe(schedule, 2, 3, 3);
+    assert(next_use_of(schedule, 2) == 6);
+    assert(next_use_of(schedule, 3) == 4);
+    free_next_use(schedule);
+    return 0;
+}
+
+/*
+ * A random recording replayed as it was recorded, checking each next use against a scan of the runs
+ */
+int test_next_use_replay() {
+    long long int pids[NEXT_USE_TEST_RUNS];
+    next_use_t* schedule = create_next_use();
+    srand(17);
+    long long int tick = 0;
+    for (int run = 0; run < NEXT_USE_TEST_RUNS; run++) {
+        /* Consecutive runs of one process are separated by an idle tick */
+        pids[run] = rand() % NEXT_USE_TEST_PIDS;
+        if (run > 0 && pids[run] == pids[run - 1]) {
+            tick++;
+        }
+        long long int length = 1 + rand() % 5;
+        next_use_observe(schedule, pids[run], tick, tick + length - 1);
+        tick += length;
+    }
+    assert(schedule->run_count == NEXT_USE_TEST_RUNS);
+
+    next_use_replay(schedule);
+    tick = 0;
+    for (int run = 0; run <= NEXT_USE_TEST_RUNS; run++) {
+        for (long long int pid = 0; pid < NEXT_USE_TEST_PIDS; pid++) {
+            long long int expected = NEVER_USED;
+            for (int later = run; later < NEXT_USE_TEST_RUNS; later++) {
+                if (pids[later] == pid) {
+                    expected = later + 1;
+                    break;
+                }
+            }
+            assert(next_use_of(schedule, pid) == expected);
+        }
+        if (run < NEXT_USE_TEST_RUNS) {
+            next_use_observe(schedule, pids[run], tick, tick);
+            tick += 2;
+        }
+    }
+    free_next_use(schedule);
+    return 0;
+}
+
+int next_use_test() {
+    test_next_use_runs();
+    test_next_use_replay();
+    return 0;
+}
@@ -0,0 +1,10 @@
+//
+// Tests for the recorded schedule of the OPT policy
+//
+
+#ifndef SCHEDULER_NEXT_USE_TEST_H
+#define SCHEDULER_NEXT_USE_TEST_H
+
+int next_use_test();
+
+#endif //SCHEDULER_NEXT_USE_TEST_H
@@ -0,0 +1,135 @@
+//
+// Tests for the pid map
+//
+
+#include "pid_map_test.h"
+#include "../src/pid_map.h"
+#include <stdio.h>
+
+#define PID_MAP_TEST_CAPACITY 64
+#define PID_MAP_TEST_PIDS 300
+#define PID_MAP_TEST_ROUNDS 20000
+
+/*
+ * Same hash as the pid map, to pick pids with a chosen home slot
+ */
+long long int home_slot(long long int pid, long long int capacity) {
+    unsigned long long x = (unsigned long long)pid;
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    return (long long int)(x & (capacity - 1));
+}
+
+/*
+ * Fill pids with the next count pids, after the previous pid, whose home slot is the given slot
+ */
+long long int find_colliding_pids(long long int* pids, int count, long long int slot, long long int previous) {
+    for (int i = 0; i < count; i++) {
+        do {
+            previous++;
+        } while (home_slot(previous, PID_MAP_TEST_CAPACITY) != slot);
+        pids[i] = previous;
+    }
+    return previous;
+}
+
+/*
+ * Pids in the map map to their own address, the others are not found
+ */
+void check_pids(pid_map_t* map, long long int* pids, bool* present, int count) {
+    long long int size = 0;
+    for (int i = 0; i < count; i++) {
+        if (present[i]) {
+            assert(pid_map_get(map, pids[i]) == &pids[i]);
+            size++;
+        } else {
+            assert(pid_map_get(map, pids[i]) == NULL);
+        }
+    }
+    assert(pid_map_size(map) == size);
+}
+
+/*
+ * Colliding pids whose probe sequences run past the end of the table and wrap to the start
+ */
+int test_pid_map_collisions() {
+    /* 5 pids at home slot 62, 5 at 63 and 3 at 0, so both runs wrap and interleave */
+    long long int pids[13];
+    bool present[13];
+    long long int last = find_colliding_pids(pids, 5, PID_MAP_TEST_CAPACITY - 2, 0);
+    last = find_colliding_pids(pids + 5, 5, PID_MAP_TEST_CAPACITY - 1, 0);
+    find_colliding_pids(pids + 10, 3, 0, last);
+    pid_map_t* map = create_pid_map();
+    assert(map->capacity == PID_MAP_TEST_CAPACITY);
+    for (int i = 0; i < 13; i++) {
+        pid_map_put(map, pids[i], &pids[i]);
+        present[i] = true;
+    }
+    check_pids(map, pids, present, 13);
+    /* The run from slot 62 covers 62, 63 and wraps to slots 0 to 10 */
+    for (long long int slot = 0; slot <= 10; slot++) {
+        assert(map->entries[slot].used);
+    }
+    assert(!map->entries[11].used);
+
+    /* Remove from the start, the middle and the wrapped part of the run */
+    int removals[] = {0, 7, 2, 12, 5, 10};
+    for (int i = 0; i < 6; i++) {
+        assert(pid_map_remove(map, pids[removals[i]]) == &pids[removals[i]]);
+        present[removals[i]] = false;
+        assert(pid_map_remove(map, pids[removals[i]]) == NULL);
+        check_pids(map, pids, present, 13);
+    }
+    /* Putting again replaces the value */
+    pid_map_put(map, pids[8], &pids[0]);
+    assert(pid_map_get(map, pids[8]) == &pids[0]);
+    pid_map_put(map, pids[8], &pids[8]);
+    for (int i = 0; i < 13; i++) {
+        if (present[i]) {
+            assert(pid_map_remove(map, pids[i]) == &pids[i]);
+            present[i] = false;
+        }
+    }
+    check_pids(map, pids, present, 13);
+    for (long long int slot = 0; slot < map->capacity; slot++) {
+        assert(!map->entries[slot].used);
+    }
+    free_pid_map(map);
+    return 0;
+}
+
+/*
+ * Random puts and removals, through growth, against a table indexed by pid
+ */
+int test_pid_map_random() {
+    long long int pids[PID_MAP_TEST_PIDS];
+    bool present[PID_MAP_TEST_PIDS] = {false};
+    pid_map_t* map = create_pid_map();
+    srand(5);
+    for (int i = 0; i < PID_MAP_TEST_PIDS; i++) {
+        pids[i] = i;
+    }
+    for (int round = 0; round < PID_MAP_TEST_ROUNDS; round++) {
+        int i = rand() % PID_MAP_TEST_PIDS;
+        if (rand() % 3 == 0) {
+            assert(pid_map_remove(map, pids[i]) == (present[i] ? &pids[i] : NULL));
+            present[i] = false;
+        } else {
+            pid_map_put(map, pids[i], &pids[i]);
+            present[i] = true;
+        }
+        if (round % 100 == 0) {
+            check_pids(map, pids, present, PID_MAP_TEST_PIDS);
+        }
+    }
+    check_pids(map, pids, present, PID_MAP_TEST_PIDS);
+    free_pid_map(map);
+    return 0;
+}
+
+int pid_map_test() {
+    test_pid_map_collisions();
+    test_pid_map_random();
+    return 0;
+}
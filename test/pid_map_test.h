@@ -0,0 +1,10 @@
+//
+// Tests for the pid map
+//
+
+#ifndef SCHEDULER_PID_MAP_TEST_H
+#define SCHEDULER_PID_MAP_TEST_H
+
+int pid_map_test();
+
+#endif //SCHEDULER_PID_MAP_TEST_H
@@ -0,0 +1,134 @@
+//
+// Tests for the binary trace format
+//
+
+#include "trace_test.h"
+#include "../src/trace.h"
+#include <stdio.h>
+#include <unistd.h>
+
+#define TRACE_TEST_RECORDS 5000
+
+/*
+ * Records of a text trace, one column per field as in the binary trace
+ */
+typedef struct trace_records {
+    long long int count;
+    long long int time[TRACE_TEST_RECORDS];
+    long long int pid[TRACE_TEST_RECORDS];
+    long long int memory[TRACE_TEST_RECORDS];
+    long long int job_time[TRACE_TEST_RECORDS];
+} trace_records_t;
+
+/*
+ * A random value whose varint takes from one to nine bytes
+ */
+long long int random_width_value() {
+    int bits = 1 + rand() % 62;
+    return (((long long int)rand() << 31) ^ rand()) & ((1LL << bits) - 1);
+}
+
+/*
+ * Random records whose arrival times mostly rise but also fall back, by a little or by a lot
+ */
+void random_trace_records(trace_records_t* records, long long int count) {
+    long long int time = 0;
+    records->count = count;
+    for (long long int i = 0; i < count; i++) {
+        switch (rand() % 8) {
+            case 0:
+                time -= 1 + rand() % 64;
+                break;
+            case 1:
+                /* Jump anywhere, negative times included */
+                time = random_width_value() - random_width_value();
+                break;
+            default:
+                time += rand() % 3;
+                break;
+        }
+        records->time[i] = time;
+        records->pid[i] = random_width_value();
+        records->memory[i] = random_width_value();
+        records->job_time[i] = random_width_value();
+    }
+}
+
+/*
+ * Writes records as a text workload, converts it and reads the binary trace back, comparing every record
+ */
+void check_round_trip(trace_records_t* records) {
+    char textFile[] = "/tmp/trace_test_XXXXXX";
+    char binaryFile[] = "/tmp/trace_test_XXXXXX";
+    int text = mkstemp(textFile);
+    int binary = mkstemp(binaryFile);
+    assert(text >= 0 && binary >= 0);
+    close(text);
+    close(binary);
+    FILE* fp = fopen(textFile, "w");
+    assert(fp);
+    for (long long int i = 0; i < records->count; i++) {
+        fprintf(fp, "%lld %lld %lld %lld\n", records->time[i], records->pid[i], records->memory[i], records->job_time[i]);
+    }
+    assert(fclose(fp) == 0);
+
+    assert(convert_trace(textFile, binaryFile) == records->count);
+    assert(is_binary_trace(binaryFile) && !is_binary_trace(textFile));
+    trace_t* trace = open_trace(binaryFile);
+    assert(trace->record_count == records->count);
+    trace_cursor_t cursor;
+    trace_cursor_init(trace, &cursor);
+    long long int time, pid, memory, jobTime;
+    for (long long int i = 0; i < records->count; i++) {
+        assert(trace_next(&cursor, &time, &pid, &memory, &jobTime));
+        assert(time == records->time[i]);
+        assert(pid == records->pid[i]);
+        assert(memory == records->memory[i]);
+        assert(jobTime == records->job_time[i]);
+    }
+    assert(!trace_next(&cursor, &time, &pid, &memory, &jobTime));
+    /* Every column was read to its end */
+    for (int i = 0; i < TRACE_COLUMNS; i++) {
+        assert(cursor.column[i] == cursor.column_end[i]);
+    }
+    close_trace(trace);
+    unlink(textFile);
+    unlink(binaryFile);
+}
+
+/*
+ * Round trips of an empty trace, a single record and random traces
+ */
+int test_trace_round_trip() {
+    static trace_records_t records;
+    srand(2);
+    random_trace_records(&records, 0);
+    check_round_trip(&records);
+    random_trace_records(&records, 1);
+    records.time[0] = -5;
+    check_round_trip(&records);
+    for (int round = 0; round < 4; round++) {
+        random_trace_records(&records, TRACE_TEST_RECORDS);
+        check_round_trip(&records);
+    }
+    return 0;
+}
+
+/*
+ * A missing text workload is reported rather than converted
+ */
+int test_trace_missing_input() {
+    char binaryFile[] = "/tmp/trace_test_XXXXXX";
+    int binary = mkstemp(binaryFile);
+    assert(binary >= 0);
+    close(binary);
+    unlink(binaryFile);
+    assert(convert_trace(binaryFile, binaryFile) == -1);
+    return 0;
+}
+
+int trace_test() {
+    test_trace_round_trip();
+    test_trace_missing_input();
+    return 0;
+}
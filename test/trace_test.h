@@ -0,0 +1,10 @@
+//
+// Tests for the binary trace format
+//
+
+#ifndef SCHEDULER_TRACE_TEST_H
+#define SCHEDULER_TRACE_TEST_H
+
+int trace_test();
+
+#endif //SCHEDULER_TRACE_TEST_H
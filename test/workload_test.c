@@ -0,0 +1,113 @@
+//
+// Tests for the arrival batches of the workload
+//
+
+#include "workload_test.h"
+#include "../src/workload.h"
+#include <stdio.h>
+#include <unistd.h>
+
+#define WORKLOAD_TEST_TICKS 300
+#define WORKLOAD_TEST_MAX_BATCH 150
+#define WORKLOAD_TEST_PROCESSES (WORKLOAD_TEST_TICKS * WORKLOAD_TEST_MAX_BATCH)
+
+/*
+ * Processes of the trace, indexed by pid, and the number arriving at each tick
+ */
+typedef struct workload_trace {
+    long long int memory[WORKLOAD_TEST_PROCESSES];
+    long long int job_time[WORKLOAD_TEST_PROCESSES];
+    long long int arrived[WORKLOAD_TEST_PROCESSES];
+    long long int arrivals[WORKLOAD_TEST_TICKS];
+} workload_trace_t;
+
+/*
+ * Writes a text trace where each tick has a random number of arrivals, some of the ticks listed out of pid order.
+ * Pids are handed out in tick order, so the arrivals of a tick are the pids between those of the ticks around it.
+ */
+void write_workload_trace(char* fileName, workload_trace_t* trace) {
+    long long int pids[WORKLOAD_TEST_MAX_BATCH];
+    FILE* fp = fopen(fileName, "w");
+    assert(fp);
+    long long int next_pid = 0;
+    for (long long int clock = 0; clock < WORKLOAD_TEST_TICKS; clock++) {
+        /* Mostly small batches, sometimes none and sometimes more than the initial batch capacity */
+        long long int count = rand() % 10 == 0 ? rand() % WORKLOAD_TEST_MAX_BATCH : rand() % 4;
+        for (long long int i = 0; i < count; i++) {
+            pids[i] = next_pid + i;
+        }
+        if (rand() % 2 == 0) {
+            for (long long int i = count - 1; i > 0; i--) {
+                long long int j = rand() % (i + 1);
+                long long int pid = pids[i];
+                pids[i] = pids[j];
+                pids[j] = pid;
+            }
+        }
+        for (long long int i = 0; i < count; i++) {
+            trace->memory[pids[i]] = 4 * (1 + rand() % 100);
+            trace->job_time[pids[i]] = 1 + rand() % 1000;
+            trace->arrived[pids[i]] = clock;
+            fprintf(fp, "%lld %lld %lld %lld\n", clock, pids[i], trace->memory[pids[i]], trace->job_time[pids[i]]);
+        }
+        trace->arrivals[clock] = count;
+        next_pid += count;
+    }
+    assert(fclose(fp) == 0);
+}
+
+/*
+ * Takes the arrivals of every tick, checking each batch has every process of the tick once, sorted by pid
+ */
+void check_workload_batches(char* fileName, workload_trace_t* trace) {
+    process_t** arrivals;
+    workload_t* workload = open_workload(fileName);
+    long long int next_pid = 0;
+    for (long long int clock = 0; clock < WORKLOAD_TEST_TICKS; clock++) {
+        assert(workload_pending(workload));
+        long long int count = workload_pop_arrivals(workload, clock, &arrivals);
+        assert(count == trace->arrivals[clock]);
+        for (long long int i = 0; i < count; i++) {
+            process_t* process = arrivals[i];
+            assert(process->pid == next_pid + i);
+            assert(process->timeArrived == clock && trace->arrived[process->pid] == clock);
+            assert(process->memory == trace->memory[process->pid]);
+            assert(process->job_time == trace->job_time[process->pid]);
+            free_process(process);
+        }
+        next_pid += count;
+        /* The next arrival is left for its own tick */
+        assert(workload_pop_arrivals(workload, clock, &arrivals) == 0);
+        assert(!workload_pending(workload) || workload_next(workload)->timeArrived > clock);
+    }
+    assert(!workload_pending(workload));
+    assert(workload->count == next_pid);
+    close_workload(workload);
+}
+
+/*
+ * The same trace read as text and as a binary trace gives the same batches
+ */
+int test_workload_batches() {
+    static workload_trace_t trace;
+    char textFile[] = "/tmp/workload_test_XXXXXX";
+    char binaryFile[] = "/tmp/workload_test_XXXXXX";
+    int text = mkstemp(textFile);
+    int binary = mkstemp(binaryFile);
+    assert(text >= 0 && binary >= 0);
+    close(text);
+    close(binary);
+    srand(24);
+    write_workload_trace(textFile, &trace);
+    check_workload_batches(textFile, &trace);
+    assert(convert_trace(textFile, binaryFile) >= 0);
+    check_workload_batches(binaryFile, &trace);
+    unlink(textFile);
+    unlink(binaryFile);
+    return 0;
+}
+
+int workload_test() {
+    test_workload_batches();
+    return 0;
+}
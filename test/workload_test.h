@@ -0,0 +1,10 @@
+//
+// Tests for the arrival batches of the workload
+//
+
+#ifndef SCHEDULER_WORKLOAD_TEST_H
+#define SCHEDULER_WORKLOAD_TEST_H
+
+int workload_test();
+
+#endif //SCHEDULER_WORKLOAD_TEST_H